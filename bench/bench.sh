@@ -0,0 +1,55 @@
+#!/bin/sh
+# Benchmark: aynı sentetik iş yükünü tüm çalıştırma modları ve kilit backend'leriyle
+# çalıştırır; verim, gecikme yüzdelikleri ve kilit bekleme oranını tablo olarak yazar.
+# Ayarlar ortam değişkenleriyle verilir (make bench varsayılanları Makefile'da).
+set -e
+
+BANK=${BANK:-./bank}
+GEN=${GEN:-./bank-gen}
+DATA=${BENCH_DATA:-bench/data}
+TXNS=${BENCH_TXNS:-1000000}
+ACCOUNTS=${BENCH_ACCOUNTS:-10000}
+MIX=${BENCH_MIX:-30,20,50}
+SKEW=${BENCH_SKEW:-0.99}
+FORK_TXNS=${BENCH_FORK_TXNS:-20000}
+WORKERS=${BENCH_WORKERS:-}
+
+mkdir -p "$DATA"
+
+# Düzgün dağılımlı ve sıcak hesaplı (Zipf) iki iş yükü; fork modu için daha küçük dosya
+$GEN -n "$TXNS" -a "$ACCOUNTS" -x "$MIX" -z 0 "$DATA/accounts.txt" "$DATA/uniform.txt" > /dev/null
+$GEN -n "$TXNS" -a "$ACCOUNTS" -x "$MIX" -z "$SKEW" "$DATA/accounts.txt" "$DATA/skewed.txt" > /dev/null
+$GEN -n "$FORK_TXNS" -a "$ACCOUNTS" -x "$MIX" -z 0 "$DATA/accounts.txt" "$DATA/fork.txt" > /dev/null
+
+echo "Workload: $TXNS transactions ($FORK_TXNS in fork mode), $ACCOUNTS accounts, mix $MIX, skew $SKEW"
+printf "\n%-9s %-24s %12s %9s %9s %9s %10s %8s\n" \
+       "workload" "mode" "txn/s" "p50 us" "p99 us" "p99.9 us" "max us" "lock %"
+
+# run WORKLOAD MODE_NAME FILE BANK_OPTIONS...
+run() {
+    workload=$1
+    name=$2
+    file=$3
+    shift 3
+    $BANK -q -b ${WORKERS:+-w $WORKERS} -a "$DATA/accounts.txt" -t "$file" "$@" | awk \
+        -v workload="$workload" -v name="$name" '
+        /^Benchmark:/ { tps = $7; sub(/^\(/, "", tps) }
+        /^Latency/    { p50 = $4; p99 = $6; p999 = $8; max = $10
+                        sub(/,/, "", p50); sub(/,/, "", p99); sub(/,/, "", p999) }
+        /^Lock wait:/ { lock = $5; sub(/^\(/, "", lock); sub(/%/, "", lock) }
+        END { printf "%-9s %-24s %12s %9s %9s %9s %10s %8s\n", workload, name, tps, p50, p99, p999, max, lock }'
+}
+
+for workload in uniform skewed; do
+    file="$DATA/$workload.txt"
+    run "$workload" "pool futex"              "$file" -m pool -l futex
+    run "$workload" "pool futex lock-free"    "$file" -m pool -l futex -c
+    run "$workload" "pool sem"                "$file" -m pool -l sem
+    run "$workload" "pool sem lock-free"      "$file" -m pool -l sem -c
+    run "$workload" "sched"                   "$file" -m sched
+    run "$workload" "ordered"                 "$file" -m ordered
+    run "$workload" "serial"                  "$file" -m serial
+    run "$workload" "shard"                   "$file" -m shard
+done
+run "uniform" "fork futex" "$DATA/fork.txt" -m fork -l futex
+run "uniform" "fork sem"   "$DATA/fork.txt" -m fork -l sem
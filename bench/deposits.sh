@@ -0,0 +1,49 @@
+#!/bin/sh
+# Benchmark: yatırmaların ön toplanması (-d) açık ve kapalı
+# İş yükünün çoğu birkaç sıcak hesaba (Zipf) yatırmadır; -d ile aynı hesaba ardışık
+# yatırmalar parça içinde tek bir bakiye güncellemesi (tek kilit) olarak uygulanır.
+set -e
+
+GEN=${GEN:-./bank-gen}
+BANK=${BANK:-./bank}
+DATA=${BENCH_DATA:-bench/data}
+TXNS=${BENCH_TXNS:-1000000}
+ACCOUNTS=${BENCH_ACCOUNTS:-10000}
+MIX=${BENCH_DEPOSIT_MIX:-90,5,5}
+SKEW=${BENCH_DEPOSIT_SKEW:-1.2}
+WORKERS=${BENCH_WORKERS:-}
+
+mkdir -p "$DATA"
+
+$GEN -n "$TXNS" -a "$ACCOUNTS" -x "$MIX" -z "$SKEW" \
+    "$DATA/deposits-accounts.txt" "$DATA/deposits.txt" > /dev/null
+
+echo "Workload: $TXNS transactions over $ACCOUNTS accounts, mix $MIX, Zipf skew $SKEW"
+printf "\n%-20s %-6s %12s %9s %9s %8s %10s\n" \
+       "mode" "-d" "txn/s" "p50 us" "p99 us" "lock %" "saved"
+
+# run MODE_NAME BANK_OPTIONS...
+run() {
+    name=$1
+    shift
+    for aggregate in off on; do
+        flag=
+        if [ "$aggregate" = on ]; then
+            flag=-d
+        fi
+        $BANK -q -b ${WORKERS:+-w $WORKERS} $flag -a "$DATA/deposits-accounts.txt" \
+            -t "$DATA/deposits.txt" "$@" | awk -v name="$name" -v aggregate="$aggregate" '
+            /^Benchmark:/ { tps = $7; sub(/^\(/, "", tps) }
+            /^Latency/    { p50 = $4; p99 = $6; sub(/,/, "", p50); sub(/,/, "", p99) }
+            /^Lock wait:/ { lock = $5; sub(/^\(/, "", lock); sub(/%/, "", lock) }
+            /^Deposits:/  { saved = $2 - $6 }
+            END { printf "%-20s %-6s %12s %9s %9s %8s %10s\n", name, aggregate, tps, p50, p99,
+                         (lock == "" ? "-" : lock), (saved == "" ? "-" : saved) }'
+    done
+}
+
+run "pool futex" -m pool -l futex
+run "pool sem" -m pool -l sem
+run "pool futex -c" -m pool -l futex -c
+run "ordered" -m ordered
+run "serial" -m serial
@@ -0,0 +1,47 @@
+#!/bin/sh
+# Benchmark: işçi process'leri (-e processes) ile aynı process'in thread'leri (-e threads)
+# Her mod iki motorla aynı dosyalarda çalışır. "wall s" IPC kurulumu, fork/pthread_create,
+# dosya okuma ve sonlandırma dahil tüm çalıştırmanın süresidir.
+set -e
+
+GEN=${GEN:-./bank-gen}
+BANK=${BANK:-./bank}
+DATA=${BENCH_DATA:-bench/data}
+TXNS=${BENCH_TXNS:-1000000}
+ACCOUNTS=${BENCH_ACCOUNTS:-10000}
+SKEW=${BENCH_SKEW:-0.99}
+WORKERS=${BENCH_WORKERS:-}
+
+mkdir -p "$DATA"
+
+$GEN -n "$TXNS" -a "$ACCOUNTS" -z "$SKEW" "$DATA/engines-accounts.txt" "$DATA/engines.txt" > /dev/null
+
+echo "Workload: $TXNS transactions over $ACCOUNTS accounts, Zipf skew $SKEW"
+printf "\n%-22s %-10s %12s %9s %9s %8s %8s\n" \
+       "mode" "engine" "txn/s" "p50 us" "p99 us" "lock %" "wall s"
+
+# run MODE_NAME BANK_OPTIONS...
+run() {
+    name=$1
+    shift
+    for engine in processes threads; do
+        start=$(date +%s.%N)
+        output=$($BANK -q -b ${WORKERS:+-w $WORKERS} -e $engine -a "$DATA/engines-accounts.txt" \
+            -t "$DATA/engines.txt" "$@")
+        end=$(date +%s.%N)
+        echo "$output" | awk -v name="$name" -v engine="$engine" -v start="$start" -v end="$end" '
+            /^Benchmark:/ { tps = $7; sub(/^\(/, "", tps) }
+            /^Latency/    { p50 = $4; p99 = $6; sub(/,/, "", p50); sub(/,/, "", p99) }
+            /^Lock wait:/ { lock = $5; sub(/^\(/, "", lock); sub(/%/, "", lock) }
+            END { printf "%-22s %-10s %12s %9s %9s %8s %8.3f\n", name, engine, tps, p50, p99,
+                         (lock == "" ? "-" : lock), end - start }'
+    done
+}
+
+run "pool futex" -m pool -l futex
+run "pool futex -c" -m pool -l futex -c
+run "sched" -m sched
+run "ordered" -m ordered
+run "shard" -m shard
+run "pool futex journal" -m pool -l futex -j "$DATA/engines.journal"
+rm -f "$DATA/engines.journal"
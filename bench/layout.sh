@@ -0,0 +1,47 @@
+#!/bin/sh
+# Benchmark: hesap düzeninin (LAYOUT=dense / LAYOUT=padded) etkisi
+# İş yükü komşu hesaplar arasında transferdir (bank-gen -A): aynı anda çalışan
+# worker'lar farklı kilitleri tutsa da dense düzende aynı cache line'a yazarlar.
+# İki düzen ayrı ayrı derlenir, sonunda varsayılan (dense) derleme geri yüklenir.
+set -e
+
+GEN=${GEN:-./bank-gen}
+DATA=${BENCH_DATA:-bench/data}
+TXNS=${BENCH_TXNS:-1000000}
+ACCOUNTS=${BENCH_LAYOUT_ACCOUNTS:-64}
+MIX=${BENCH_LAYOUT_MIX:-0,0,100}
+WORKERS=${BENCH_WORKERS:-}
+
+mkdir -p "$DATA"
+
+for layout in dense padded; do
+    make -s LAYOUT=$layout bank > /dev/null
+    cp bank "$DATA/bank-$layout"
+done
+make -s > /dev/null
+
+$GEN -A -n "$TXNS" -a "$ACCOUNTS" -x "$MIX" "$DATA/adjacent-accounts.txt" "$DATA/adjacent.txt" > /dev/null
+
+echo "Workload: $TXNS adjacent transactions over $ACCOUNTS accounts, mix $MIX"
+printf "\n%-8s %-24s %12s %9s %9s %9s %8s\n" \
+       "layout" "mode" "txn/s" "p50 us" "p99 us" "p99.9 us" "lock %"
+
+# run LAYOUT MODE_NAME BANK_OPTIONS...
+run() {
+    layout=$1
+    name=$2
+    shift 2
+    "$DATA/bank-$layout" -q -b ${WORKERS:+-w $WORKERS} -a "$DATA/adjacent-accounts.txt" \
+        -t "$DATA/adjacent.txt" "$@" | awk -v layout="$layout" -v name="$name" '
+        /^Benchmark:/ { tps = $7; sub(/^\(/, "", tps) }
+        /^Latency/    { p50 = $4; p99 = $6; p999 = $8
+                        sub(/,/, "", p50); sub(/,/, "", p99); sub(/,/, "", p999) }
+        /^Lock wait:/ { lock = $5; sub(/^\(/, "", lock); sub(/%/, "", lock) }
+        END { printf "%-8s %-24s %12s %9s %9s %9s %8s\n", layout, name, tps, p50, p99, p999, lock }'
+}
+
+for layout in dense padded; do
+    run "$layout" "pool futex"           -m pool -l futex
+    run "$layout" "pool sem"             -m pool -l sem
+    run "$layout" "shard"                -m shard
+done
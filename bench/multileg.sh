@@ -0,0 +1,48 @@
+#!/bin/sh
+# Benchmark: çok ayaklı işlem (T_type 3) ile aynı ödemelerin transfer zinciri olarak yazılması
+# Her ödeme bir hesaptan LEGS-1 hesaba paradır. Zincir, telafi (compensation) transferleri
+# hiç gerekmeyen en iyi durumdur; yine de ödeme başına LEGS-1 işlem, kilit seti ve log kaydı ister.
+set -e
+
+GEN=${GEN:-./bank-gen}
+BANK=${BANK:-./bank}
+DATA=${BENCH_DATA:-bench/data}
+TXNS=${BENCH_TXNS:-1000000}
+ACCOUNTS=${BENCH_ACCOUNTS:-10000}
+LEGS=${BENCH_LEGS:-5}
+WORKERS=${BENCH_WORKERS:-}
+
+mkdir -p "$DATA"
+
+# Bakiyeler hiçbir ödemenin başarısız olmayacağı kadar büyük: iki dosya aynı sonucu verir
+$GEN -n "$TXNS" -a "$ACCOUNTS" -x 0,0,100 -B 1000000000 -L "$LEGS" \
+    "$DATA/multileg-accounts.txt" "$DATA/multileg.txt" > /dev/null
+$GEN -n "$TXNS" -a "$ACCOUNTS" -x 0,0,100 -B 1000000000 -L "$LEGS" -E \
+    "$DATA/multileg-accounts.txt" "$DATA/multileg-chain.txt" > /dev/null
+
+echo "Workload: $TXNS settlements of $LEGS legs over $ACCOUNTS accounts"
+printf "\n%-12s %-22s %12s %12s %9s %9s\n" \
+       "encoding" "mode" "settle/s" "txn/s" "p50 us" "p99 us"
+
+# run ENCODING MODE_NAME FILE BANK_OPTIONS...
+run() {
+    encoding=$1
+    name=$2
+    file=$3
+    shift 3
+    $BANK -q -b ${WORKERS:+-w $WORKERS} -a "$DATA/multileg-accounts.txt" -t "$file" "$@" |
+        awk -v encoding="$encoding" -v name="$name" -v settlements="$TXNS" '
+        /^Benchmark:/ { seconds = $5; tps = $7; sub(/^\(/, "", tps) }
+        /^Latency/    { p50 = $4; p99 = $6; sub(/,/, "", p50); sub(/,/, "", p99) }
+        END { printf "%-12s %-22s %12.0f %12s %9s %9s\n", encoding, name,
+                     (seconds > 0 ? settlements / seconds : 0), tps, p50, p99 }'
+}
+
+for mode in "pool futex:-m pool -l futex" "pool sem:-m pool -l sem" "ordered:-m ordered" \
+            "pool futex journal:-m pool -l futex -j $DATA/multileg.journal"; do
+    name=${mode%%:*}
+    options=${mode#*:}
+    run "multi-leg" "$name" "$DATA/multileg.txt" $options
+    run "chain" "$name" "$DATA/multileg-chain.txt" $options
+done
+rm -f "$DATA/multileg.journal"
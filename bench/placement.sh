@@ -0,0 +1,43 @@
+#!/bin/sh
+# Benchmark: worker'ların çekirdeklere sabitlenmesi (-p) ve NUMA bellek yerleşimi (-N)
+# Her mod yerleşimsiz, sabitlenmiş, dağıtılmış (interleave) ve bölünmüş (partition) bellekle
+# çalışır; node başına verim bank'ın kendi raporundan okunur. Tek node'lu makinede -N atlanır.
+set -e
+
+GEN=${GEN:-./bank-gen}
+BANK=${BANK:-./bank}
+DATA=${BENCH_DATA:-bench/data}
+TXNS=${BENCH_TXNS:-1000000}
+ACCOUNTS=${BENCH_ACCOUNTS:-10000}
+WORKERS=${BENCH_WORKERS:-}
+
+mkdir -p "$DATA"
+
+$GEN -n "$TXNS" -a "$ACCOUNTS" "$DATA/placement-accounts.txt" "$DATA/placement.txt" > /dev/null
+
+echo "Workload: $TXNS transactions over $ACCOUNTS accounts"
+printf "\n%-10s %-12s %12s %9s %9s  %s\n" "mode" "placement" "txn/s" "p50 us" "p99 us" "per node txn/s"
+
+# run MODE_NAME BANK_OPTIONS...
+run() {
+    name=$1
+    shift
+    for placement in none pin interleave partition; do
+        case $placement in
+            none) flag= ;;
+            pin) flag=-p ;;
+            *) flag="-N $placement" ;;
+        esac
+        $BANK -q -b ${WORKERS:+-w $WORKERS} $flag -a "$DATA/placement-accounts.txt" \
+            -t "$DATA/placement.txt" "$@" | awk -v name="$name" -v placement="$placement" '
+            /^Benchmark:/ { tps = $7; sub(/^\(/, "", tps) }
+            /^Latency/    { p50 = $4; p99 = $6; sub(/,/, "", p50); sub(/,/, "", p99) }
+            /^Node /      { rate = $(NF - 1); sub(/^\(/, "", rate); nodes = nodes " " $2 rate }
+            END { printf "%-10s %-12s %12s %9s %9s %s\n", name, placement, tps, p50, p99,
+                         (nodes == "" ? " -" : nodes) }'
+    done
+}
+
+run "pool" -m pool -l futex
+run "ordered" -m ordered
+run "shard" -m shard
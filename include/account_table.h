@@ -0,0 +1,244 @@
+#ifndef ACCOUNT_TABLE_H   // Eğer ACCOUNT_TABLE_H tanımlı değilse
+#define ACCOUNT_TABLE_H   // ACCOUNT_TABLE_H'yi tanımla (header guard)
+
+#include <stddef.h>       // size_t
+#include <stdint.h>       // int64_t, uint64_t
+#include "accounts.h"     // Account
+
+// Cache line boyutu (x86 ve çoğu ARM çekirdeği için 64 byte)
+#define CACHE_LINE_SIZE 64
+
+/*
+ * Futex tabanlı hesap kilidi (shared memory'de, hesap dizisinin hemen arkasında durur)
+ * state: 0 = açık, 1 = kilitli, 2 = kilitli ve bekleyen process var
+ * Milyonlarca hesapta kilit başına bir cache line çok bellek harcadığı için
+ * kilitler varsayılan derlemede sıkışık dizilir (4 byte)
+ */
+typedef struct {
+    int state;
+} AccountLock;
+
+#ifdef ACCOUNT_LAYOUT_PADDED
+/*
+ * 🧱 LAYOUT=padded: hesabın işlemler sırasında yazılan durumu kendi cache line'ında
+ * Varsayılan düzende bir cache line'da 4 hesap ve 16 kilit durur; komşu hesapları
+ * güncelleyen worker'lar farklı kilitler tutsa bile aynı satır için yarışır (false sharing).
+ * Bu düzende her hesabın bakiyesi ve kilidi ayrı bir satırdadır; kilidi alan bakiyeyi de
+ * getirir. Sadece okunan ID'ler hesap dizisinde ve indekste sıkışık kalır.
+ * balance: Asıl bakiye (hesap dizisindeki balance kullanılmaz)
+ * lock: Futex kilidi (LOCK_FUTEX)
+ * epoch / epoch_balance: Sürümlü bakiye (hesap dizisindeki epoch kullanılmaz, bkz. account_version_touch)
+ */
+typedef struct {
+    int balance;
+    AccountLock lock;
+    int epoch;
+    int epoch_balance;
+} __attribute__((aligned(CACHE_LINE_SIZE))) AccountLine;
+#endif
+
+/*
+ * 🗂️ Hash indeksinin bir yuvası (16 byte, bir cache line'a dört yuva)
+ * account_id: Hesap ID'si
+ * slot: Hesabın accounts dizisindeki yeri, -1 ise yuva boş
+ */
+typedef struct {
+    int64_t account_id;
+    int slot;
+    int reserved;
+} IndexEntry;
+
+/*
+ * Açık adresleme (linear probing) hash indeksi: hesap ID'si → dizideki yer
+ * Shared memory'de durur; başlangıçta bir kez kurulur, sonra sadece okunur,
+ * bu yüzden aramalar kilit veya atomik işlem gerektirmez
+ * entries: 2'nin kuvveti kadar yuva (doluluk en fazla 2/3)
+ * mask: Yuva sayısı - 1
+ */
+typedef struct {
+    IndexEntry *entries;
+    uint64_t mask;
+} AccountIndex;
+
+/*
+ * 🏦 Hesap tablosu: shared memory'deki hesap dizisi ve ID indeksi
+ * İşlemler hesap ID'si ile gelir; indeks ID'yi dizideki yere (slot) çevirir.
+ * Bakiyeler ve kilitler slot ile numaralanır.
+ * Fork öncesi doldurulur; child process'ler kopyasını kullanır
+ * accounts: Hesaplar
+ * num_accounts: Hesap sayısı
+ * index: ID → slot
+ * lines: Hesap başına bakiye ve kilit satırı (sadece LAYOUT=padded derlemesinde)
+ * epoch_balances: Hesabın son yazıldığı epoch'un başındaki bakiyesi (varsayılan derleme;
+ *                 LAYOUT=padded'de satırın içinde durur)
+ * write_epoch: Bu process'in çalıştırdığı işlemin epoch'u; struct process başına kopya olduğu
+ *              için worker her işlemden önce snapshot kapısından aldığı değeri buraya yazar
+ * Bakiyelere her zaman account_balance() ile erişilir
+ */
+typedef struct {
+    Account *accounts;
+    int num_accounts;
+    AccountIndex index;
+#ifdef ACCOUNT_LAYOUT_PADDED
+    AccountLine *lines;
+#else
+    int *epoch_balances;
+#endif
+    int write_epoch;
+} AccountTable;
+
+
+/*
+ * num_accounts hesap için indeksin kapladığı alan (byte)
+ */
+size_t account_index_size(int num_accounts);
+
+
+/*
+ * num_accounts hesap için bakiye satırlarının kapladığı alan (byte)
+ * Varsayılan derlemede 0: bakiyeler hesap dizisinde durur
+ */
+size_t account_lines_size(int num_accounts);
+
+
+/*
+ * num_accounts hesap için epoch başı bakiyelerinin kapladığı alan (byte)
+ * LAYOUT=padded derlemesinde 0: bakiye satırlarının içinde dururlar
+ */
+size_t account_versions_size(int num_accounts);
+
+
+/*
+ * Tabloyu shared memory'deki hesap dizisi üzerine kurar ve indeksi doldurur
+ * index_area: account_index_size() kadar alan
+ * lines_area: account_lines_size() kadar cache line hizalı alan (LAYOUT=padded
+ *             derlemesinde bakiyeler buraya kopyalanır; aksi halde kullanılmaz)
+ * versions_area: account_versions_size() kadar alan
+ * Dönüş: Başarılıysa 0, aynı ID iki kez geçiyorsa -1 (hata mesajını kendisi yazar)
+ */
+int account_table_init(AccountTable *table, Account *accounts, int num_accounts, void *index_area,
+                       void *lines_area, void *versions_area);
+
+
+/*
+ * Hesapların o anki ID ve bakiyelerini out dizisine kopyalar (snapshot ve çıktı için)
+ * out: num_accounts kadar Account
+ */
+void account_table_copy(const AccountTable *table, Account *out);
+
+
+/*
+ * 🧾 epoch başındaki tutarlı kesiti okur; işlemler bu sırada çalışmaya devam edebilir
+ * Çağırandan önce epoch'u ilerletmiş ve önceki epoch'ta başlamış işlemlerin bitmesini
+ * beklemiş olmalıdır (snapshot.h). Etiketi epoch olan hesaplarda kenara konmuş bakiye,
+ * diğerlerinde bakiyenin kendisi okunur. Çalışan işlem yoksa epoch -1 verilir.
+ * out: NULL değilse hesaplar kesitteki bakiyeleriyle buraya kopyalanır
+ * Dönüş: Kesitteki bakiyelerin toplamı
+ */
+int64_t account_table_cut(const AccountTable *table, int epoch, Account *out);
+
+
+// ID'yi indeks yuvası numarasına dağıtır (splitmix64 sonlandırıcısı)
+static inline uint64_t account_hash(int64_t account_id) {
+    uint64_t x = (uint64_t)account_id;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+
+/*
+ * 🔎 Hesap ID'sinin dizideki yerini bulur
+ * Dönüş: Slot, böyle bir hesap yoksa -1
+ */
+static inline int account_table_find(const AccountTable *table, int64_t account_id) {
+    const AccountIndex *index = &table->index;
+    uint64_t pos = account_hash(account_id) & index->mask;
+    for (;;) {
+        const IndexEntry *entry = &index->entries[pos];
+        if (entry->slot == -1) {
+            return -1;  // Boş yuvaya gelindi: ID tabloda yok
+        }
+        if (entry->account_id == account_id) {
+            return entry->slot;
+        }
+        pos = (pos + 1) & index->mask;
+    }
+}
+
+
+/*
+ * 💰 Slot'taki hesabın bakiyesi (düzenden bağımsız)
+ */
+static inline int *account_balance(const AccountTable *table, int slot) {
+#ifdef ACCOUNT_LAYOUT_PADDED
+    return &table->lines[slot].balance;
+#else
+    return &table->accounts[slot].balance;
+#endif
+}
+
+
+/*
+ * Kilitsiz tek bakiye okuma: bakiye tek bir atomik yükleme ile okunur, yarım yazılmış
+ * değer görülmez ve yazan işlemler beklemez
+ */
+static inline int account_read_balance(const AccountTable *table, int slot) {
+    return __atomic_load_n(account_balance(table, slot), __ATOMIC_RELAXED);
+}
+
+
+// Slot'taki hesabın son yazıldığı epoch
+static inline int *account_epoch(const AccountTable *table, int slot) {
+#ifdef ACCOUNT_LAYOUT_PADDED
+    return &table->lines[slot].epoch;
+#else
+    return &table->accounts[slot].epoch;
+#endif
+}
+
+
+// Slot'taki hesabın son yazıldığı epoch'un başındaki bakiyesi
+static inline int *account_epoch_balance(const AccountTable *table, int slot) {
+#ifdef ACCOUNT_LAYOUT_PADDED
+    return &table->lines[slot].epoch_balance;
+#else
+    return &table->epoch_balances[slot];
+#endif
+}
+
+
+/*
+ * 🕰️ Sürümlü bakiye: slot'taki bakiye değişmeden hemen önce çağrılır
+ * Hesaba yeni bir epoch'ta ilk kez yazılıyorsa eski bakiye kenara konur ve etiket
+ * güncellenir; kesit okuyan taraf bu hesap için kenardaki bakiyeyi kullanır.
+ * Hesaba aynı anda tek işlem yazmalıdır (kilit, dalga veya sıra ile); etiket aynı
+ * cache line'da durduğu için yazma yolu sadece bir karşılaştırma kadar uzar.
+ * Dönüş: 1 ise işlem okuyucunun kestiği epoch'tan önce başlamış ama hesabı yeni epoch'un
+ *        bir işlemi çoktan etiketlemiş; değişiklik account_version_carry() ile kenardaki
+ *        bakiyeye de eklenmelidir
+ */
+static inline int account_version_touch(const AccountTable *table, int slot) {
+    int *epoch = account_epoch(table, slot);
+    int tag = *epoch;  // Etikete sadece hesaba yazan işlem yazar
+    if (tag == table->write_epoch) {
+        return 0;
+    }
+    if (tag > table->write_epoch) {
+        return 1;
+    }
+    *account_epoch_balance(table, slot) = *account_balance(table, slot);
+    __atomic_store_n(epoch, table->write_epoch, __ATOMIC_RELEASE);
+    // Etiket bakiyenin yeni değerinden önce görünsün (seqlock yazarı gibi)
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return 0;
+}
+
+
+// Önceki epoch'un işleminin değişikliğini kesitteki bakiyeye de ekler
+static inline void account_version_carry(const AccountTable *table, int slot, int delta) {
+    *account_epoch_balance(table, slot) += delta;
+}
+
+
+#endif  // ACCOUNT_TABLE_H
@@ -1,33 +1,90 @@
 #ifndef ACCOUNTS_H
 #define ACCOUNTS_H
 
-// Maximum characters for status messages and transaction types
-#define MAX_STR_LEN 20
+#include <stdint.h>  // int64_t
 
 /**
  * @brief Account structure representing a bank account
  * 
  * This structure holds the account ID and current balance
- * It will be stored in shared memory for access by multiple processes
+ * It will be stored in shared memory for access by multiple processes.
+ * Account IDs are arbitrary (sparse) 64-bit values; the position of an
+ * account in the shared array is found through the AccountIndex
+ * (see account_table.h). The epoch tag lets readers take a consistent
+ * snapshot of all balances while transactions keep running.
  */
 typedef struct {
-    int account_id;  // Unique identifier for the account
-    int balance;     // Current account balance
+    int64_t account_id;  // Unique identifier for the account
+    int balance;         // Current account balance
+    int epoch;           // Snapshot epoch of the last write (shared memory only, 0 in files)
 } Account;
 
+/**
+ * @brief Transaction structure holding one parsed line of transactions.txt
+ * 
+ * <T_type, From_account, To_account, Amount>; records are produced by the
+ * transaction reader and handed to the workers in fixed-size chunks.
+ * The 64-bit IDs come first so the record is 24 bytes without padding.
+ */
+typedef struct {
+    int64_t from_account;  // Source account (-1 for deposits); first leg for MULTI_LEG
+    int64_t to_account;    // Destination account (-1 for withdrawals); leg count for MULTI_LEG
+    int type;              // DEPOSIT, WITHDRAW, TRANSFER or MULTI_LEG
+    int amount;            // Amount of money involved in transaction
+} Transaction;
+
+/**
+ * @brief Upper bound on the legs of one multi-leg transaction
+ *
+ * Leg buffers are sized for the worst case (every transaction of a batch
+ * using this many legs), so the bound keeps them finite.
+ */
+#ifndef MULTI_MAX_LEGS
+#define MULTI_MAX_LEGS 16
+#endif
+
+/**
+ * @brief One leg of a multi-leg (MULTI_LEG) transaction
+ *
+ * A multi-leg transaction moves money between any number of accounts at
+ * once: negative legs are debits, positive legs are credits, and the legs
+ * of a transaction add up to zero. The legs live next to the batch that
+ * holds the transaction; Transaction::from_account is the index of the
+ * first leg in that array and Transaction::to_account the number of legs.
+ */
+typedef struct {
+    int64_t account_id;  // Account touched by this leg
+    int amount;          // Signed amount: < 0 debit, > 0 credit
+    int reserved;        // Keeps the record 16 bytes with no uninitialized padding
+} Leg;
+
+/**
+ * @brief Status codes stored in TransactionLog::status
+ *
+ * LOG_EMPTY marks a log slot that has been reserved but not yet written;
+ * it is never printed.
+ */
+typedef enum {
+    LOG_EMPTY = 0,
+    LOG_SUCCESS,
+    LOG_FAILED
+} LogStatus;
+
 /**
  * @brief TransactionLog structure to track all banking operations
  * 
  * This structure stores information about transactions including
- * the type, source, destination, amount, and status
+ * the type, source, destination, amount, and status. Type and status
+ * are stored as small codes (26 bytes per record) and turned into
+ * text only when the log is printed.
  */
-typedef struct {
+typedef struct __attribute__((packed)) {
     int transaction_id;            // Unique identifier for the transaction
-    char type[MAX_STR_LEN];        // "Deposit", "Withdraw", or "Transfer"
-    int from_account;              // Source account (-1 if not applicable)
-    int to_account;                // Destination account (-1 if not applicable)
+    int64_t from_account;          // Source account (-1 if not applicable)
+    int64_t to_account;            // Destination account (-1 if not applicable)
     int amount;                    // Amount of money involved in transaction
-    char status[MAX_STR_LEN];      // "Success" or "Failed"
+    unsigned char type;            // Transaction type code (see transactions.h)
+    unsigned char status;          // LogStatus; written last to publish the record
 } TransactionLog;
 
 #endif // ACCOUNTS_H
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef AGGREGATE_H       // Eğer AGGREGATE_H tanımlı değilse
+#define AGGREGATE_H       // AGGREGATE_H'yi tanımla (header guard)
+
+#include "accounts.h"       // Transaction, Leg
+#include "account_table.h"  // AccountTable
+
+/*
+ * ➕ Yatırmaların ön toplanması (-d, ana process'te, parça yayınlanmadan önce çalışır)
+ * Bir parçada aynı hesaba arka arkaya gelen yatırmalar (arada o hesaba dokunan başka
+ * işlem yokken) bir seri oluşturur. Serinin bakiyesi tek seferde, serinin son yatırması
+ * (lider) çalışırken toplam miktarla değişir; önceki yatırmalar (katlanan) sadece kendi
+ * log kayıtlarını yazar. Hesaba dokunan çekme, transfer veya çok ayaklı işlem seriyi
+ * kapatır; bu işlemler liderden sonra geldiği için toplamı görür. Journal'a seri başına
+ * tek bir yatırma kaydı (liderin ID'si, toplam miktar) yazılır.
+ */
+
+// Toplam dizisindeki değerler: pozitif değer liderin uygulayacağı toplamdır
+#define DEPOSIT_UNMERGED -1  // Seriye girmedi, işlem normal çalışır
+#define DEPOSIT_FOLDED 0     // Sonraki bir yatırmanın toplamında; bakiyeye dokunmaz
+
+/*
+ * Ön toplama durumu
+ * table: Hesap ID → slot
+ * run_last / stamp: Slot başına, hesabın açık serisinin son yatırması (stamp == epoch ise geçerli)
+ * epoch: Parça sayacı; dizileri her parçada sıfırlamamak için
+ * folded: Kendi bakiye güncellemesi yapmayan yatırma sayısı (rapor için)
+ * runs: En az iki yatırmalı seri sayısı, yani katlanan yatırmaların yerine yapılan
+ *       bakiye güncellemesi (rapor için)
+ */
+typedef struct {
+    const AccountTable *table;
+    int *run_last;
+    int *stamp;
+    int epoch;
+    long folded;
+    long runs;
+} DepositAggregator;
+
+
+// Ön toplamayı hesap tablosu için hazırlar
+void deposit_aggregator_init(DepositAggregator *aggregator, const AccountTable *table);
+
+
+// Dizileri serbest bırakır
+void deposit_aggregator_destroy(DepositAggregator *aggregator);
+
+
+/*
+ * Partideki ilk count işlemin serilerini bulur ve totals dizisini doldurur
+ * (DEPOSIT_UNMERGED, DEPOSIT_FOLDED veya liderin toplamı)
+ * Sadece pozitif miktarlı, tabloda olan hesaba yatırmalar seriye girer; toplam
+ * INT_MAX'i aşacaksa yeni bir seri başlar. Seriler partinin sonunda kapanır.
+ * legs: Partinin ayak dizisi (çok ayaklı işlemlerin hesapları)
+ */
+void aggregate_deposits(DepositAggregator *aggregator, const Transaction *txns, const Leg *legs,
+                        int count, int *totals);
+
+
+#endif  // AGGREGATE_H
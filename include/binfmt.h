@@ -0,0 +1,95 @@
+#ifndef BINFMT_H          // Eğer BINFMT_H tanımlı değilse
+#define BINFMT_H          // BINFMT_H'yi tanımla (header guard)
+
+#include <stddef.h>       // size_t
+#include <stdint.h>       // uint32_t, uint64_t
+#include "accounts.h"     // Account, Transaction
+
+// 🗂️ İkili (binary) dosya formatı
+// [BinaryHeader][kayıt 0][kayıt 1]...  Kayıtlar sabit genişlikli ve bellekteki
+// Transaction / Account yapısıyla birebir aynıdır, bu yüzden dosya mmap edilip
+// hiç parse edilmeden kullanılabilir. Sayılar makinenin kendi byte sırasındadır.
+// Çok ayaklı işlem: MULTI_LEG kaydı (to_account ayak sayısı, amount toplam borç) ve
+// ardından her ayak için bir LEG_RECORD kaydı (from_account hesap, amount işaretli miktar).
+#define BINARY_FORMAT_VERSION 2  // 2: 64 bit hesap ID'leri
+#define BINARY_MAGIC_TRANSACTIONS "BKTX"  // İşlem dosyası
+#define BINARY_MAGIC_ACCOUNTS "BKAC"      // Hesap dosyası
+
+// read_binary_accounts(): dosya ikili formatta değil (metin olarak okunmalı)
+#define BINARY_NOT_BINARY -2
+
+/*
+ * Dosya başlığı (32 byte)
+ * magic: BINARY_MAGIC_TRANSACTIONS veya BINARY_MAGIC_ACCOUNTS
+ * version: BINARY_FORMAT_VERSION
+ * record_size: Bir kaydın boyutu (sizeof(Transaction) / sizeof(Account))
+ * aux: Formata özel ek bilgi; hesap snapshot'larında snapshot'a dahil olan journal
+ *      kaydı sayısı, diğer dosyalarda 0
+ * record_count: Kayıt sayısı
+ * checksum: Tüm kayıt byte'ları üzerinden binary_checksum_*() sonucu
+ */
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t aux;
+    uint64_t record_count;
+    uint64_t checksum;
+} BinaryHeader;
+
+/*
+ * Kayıtlar üzerinde parça parça hesaplanabilen 64 bit sağlama toplamı
+ * (32 bit kelimeler üzerinde Fletcher benzeri iki toplam; byte byte CRC'den çok hızlı)
+ */
+typedef struct {
+    uint64_t sum1;
+    uint64_t sum2;
+} BinaryChecksum;
+
+
+// Sağlama toplamını başlatır
+void binary_checksum_init(BinaryChecksum *checksum);
+
+
+// size byte'lık veriyi toplama ekler (size 4'ün katı olmalı, kayıt boyutları öyledir)
+void binary_checksum_update(BinaryChecksum *checksum, const void *data, size_t size);
+
+
+// Sonucu başlığa yazılacak tek bir 64 bit değere çevirir
+uint64_t binary_checksum_final(const BinaryChecksum *checksum);
+
+
+/*
+ * Eşlenmiş dosyanın magic değeri verilen magic ile başlıyor mu?
+ * Dönüş: 1 ise ikili dosya, 0 ise değil (metin dosyası)
+ */
+int is_binary_file(const void *data, size_t size, const char *magic);
+
+
+/*
+ * Başlığı ve sağlama toplamını doğrular (hata mesajını kendisi yazar)
+ * data / size: Eşlenmiş dosyanın tamamı
+ * Dönüş: Başarılıysa 0, dosya bozuksa veya sürüm desteklenmiyorsa -1
+ */
+int binary_validate(const void *data, size_t size, const char *magic, uint32_t record_size, const char *filename);
+
+
+/*
+ * İkili hesap dosyasını okur
+ * accounts: Hesap sayısı kadar malloc ile ayrılan dizi (çağıran free eder)
+ * aux: NULL değilse başlıktaki aux değeri buraya yazılır
+ * Dönüş: Okunan hesap sayısı, dosya bozuksa -1,
+ *        dosya yoksa veya ikili formatta değilse BINARY_NOT_BINARY
+ */
+int read_binary_accounts(const char *filename, Account **accounts, uint32_t *aux);
+
+
+/*
+ * Hesapları ikili formatta yazar: önce filename.tmp yazılıp fsync edilir, sonra
+ * rename ile yerine konur; çökme anında eski dosya ya da yenisi bütün olarak kalır
+ * Dönüş: Başarılıysa 0, yazılamazsa -1
+ */
+int write_binary_accounts(const char *filename, const Account *accounts, int count, uint32_t aux);
+
+
+#endif  // BINFMT_H
@@ -0,0 +1,62 @@
+#ifndef CLIENT_H          // Eğer CLIENT_H tanımlı değilse
+#define CLIENT_H          // CLIENT_H'yi tanımla (header guard)
+
+#include <stddef.h>         // size_t
+#include "accounts.h"       // Transaction
+#include "protocol.h"       // WireRequest, WireReply, WIRE_BATCH
+
+// 📡 Daemon istemci kütüphanesi (bank-load ve diğer istemciler için)
+// İstekler tamponda biriktirilir ve toplu gönderilir; cevaplar da toplu okunur.
+// İstemci en fazla WIRE_MAX_PIPELINE cevabı okunmamış bekletmelidir.
+
+/*
+ * Daemon'a açık bir bağlantı
+ * fd: Unix domain socket
+ * next_tag: Sıradaki isteğe verilecek numara
+ * out / out_count: Gönderilmeyi bekleyen istekler
+ * in / in_bytes / in_pos: Okunmuş cevap byte'ları ve sıradaki cevabın yeri
+ */
+typedef struct {
+    int fd;
+    uint32_t next_tag;
+    WireRequest out[WIRE_BATCH];
+    int out_count;
+    char in[WIRE_BATCH * sizeof(WireReply)];
+    size_t in_bytes;
+    size_t in_pos;
+} BankClient;
+
+
+/*
+ * path'teki daemon'a bağlanır
+ * Dönüş: Başarılıysa 0, aksi halde -1
+ */
+int bank_client_connect(BankClient *client, const char *path);
+
+
+/*
+ * İşlemi gönderilecek isteklere ekler (tampon dolunca gönderilir)
+ * Dönüş: İsteğin numarası (cevaptaki tag), bağlantı koptuysa -1
+ */
+long bank_client_submit(BankClient *client, const Transaction *txn);
+
+
+/*
+ * Tamponda bekleyen istekleri gönderir
+ * Dönüş: Başarılıysa 0, bağlantı koptuysa -1
+ */
+int bank_client_flush(BankClient *client);
+
+
+/*
+ * Sıradaki cevabı okur (önce bekleyen istekler gönderilir); cevaplar istek sırasıyla gelir
+ * Dönüş: Başarılıysa 0, bağlantı kapandıysa veya koptuysa -1
+ */
+int bank_client_receive(BankClient *client, WireReply *reply);
+
+
+// Bağlantıyı kapatır
+void bank_client_close(BankClient *client);
+
+
+#endif  // CLIENT_H
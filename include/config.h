@@ -0,0 +1,91 @@
+#ifndef CONFIG_H          // Eğer CONFIG_H tanımlı değilse
+#define CONFIG_H          // CONFIG_H'yi tanımla (header guard)
+
+#include "locks.h"        // LockBackend
+#include "journal.h"      // JOURNAL_DEFAULT_GROUP, JOURNAL_DEFAULT_WINDOW_MS
+#include "snapshot.h"     // SNAPSHOT_DEFAULT_INTERVAL_MS
+#include "contention.h"   // CONTENTION_DEFAULT_TOP_K
+#include "pool.h"         // WorkerEngine, MemoryPlacement
+
+#define ACCOUNTS_FILE "accounts.txt"          // Varsayilan hesap bilgisi dosyasi
+#define TRANSACTIONS_FILE "transactions.txt"  // Varsayilan islem bilgisi dosyasi
+
+// ⚙️ Çalıştırma modları
+// MODE_FORK: Her işlem için ayrı bir child process (eski yöntem, karşılaştırma için)
+// MODE_POOL: Sabit sayıda uzun ömürlü worker process, işleri shared memory kuyruğundan çeker
+// MODE_SCHED: Pool + çakışma farkında zamanlayıcı; ortak hesabı olmayan işlemler dalga
+//             dalga kilitsiz çalışır, sonuç sıralı çalıştırmayla aynıdır
+// MODE_ORDERED: Pool + hesap başına sıra; her işlem sadece aynı hesapların önceki
+//               işlemlerini bekler, sonuç sıralı çalıştırmayla aynıdır
+// MODE_SERIAL: Worker yok; ana process dosyayı sırayla, kilitsiz çalıştırır (karşılaştırma için)
+// MODE_SHARD: Hesaplar worker'lara bölünür, her worker kendi hesaplarını kilitsiz işler;
+//             farklı shard'lar arası transferler mesajla tamamlanır
+typedef enum {
+    MODE_FORK,
+    MODE_POOL,
+    MODE_SCHED,
+    MODE_ORDERED,
+    MODE_SERIAL,
+    MODE_SHARD
+} ExecMode;
+
+/*
+ * Komut satırından okunan çalışma ayarları
+ * mode: Hangi çalıştırma modu kullanılacak?
+ * engine: Pool worker'ları process mi thread mi? (-e)
+ * num_workers: Pool modunda kaç worker process açılacak? (varsayılan: çekirdek sayısı)
+ * pin_workers: 1 ise pool worker'ları CPU çekirdeklerine sabitlenir (placement.h)
+ * memory_placement: Hesap ve log belleğinin NUMA node'larına dağılımı (-N, pin_workers'ı açar)
+ * lock_backend: Hesap kilitleri için semaphore mu futex mi kullanılacak?
+ * lock_free_single: Yatırma / çekme işlemleri kilitsiz (atomik CAS) mi yapılsın?
+ * aggregate_deposits: 1 ise aynı hesaba ardışık yatırmalar parça içinde ön toplanır (aggregate.h)
+ * accounts_file / transactions_file: Okunacak hesap ve işlem dosyaları
+ * journal_file: Uygulanan işlemlerin yazılacağı journal (NULL ise journal yok)
+ * journal_group / journal_window_ms: Kaç kayıtta veya kaç ms'de bir fdatasync yapılacağı
+ * recover: 1 ise işlem çalıştırılmaz; bakiyeler hesap dosyası (veya snapshot) + journal'dan kurulur
+ * snapshot_file: Hesapların snapshot dosyası; varsa başlangıçta hesap dosyası yerine okunur (NULL: yok)
+ * snapshot_interval_ms: Çalışma sırasında kaç ms'de bir snapshot alınacağı (0: sadece sonda)
+ * audit_interval_ms: Çalışma sırasında kaç ms'de bir tutarlı bakiye toplamı alınacağı (0: hiç)
+ * retry_attempts: 0 ise başarısız işlemler sonda bir kez hemen tekrar denenir; değilse
+ *                 ertelenmiş tekrar deneme kuyruğu, işlem başına en fazla bu kadar deneme (retry.h)
+ * retry_backoff_ms: Ertelenmiş tekrar denemede tekrar başarısız olan işlemin ilk bekleme süresi
+ * daemon_socket: NULL değilse daemon modu; işlemler bu Unix socket'ten gelir (server.h)
+ * bench: 1 ise işlem başına gecikme ve kilit bekleme süresi ölçülüp sonda yazdırılır
+ * quiet: 1 ise transaction log, tekrar denemeler ve bakiyeler yazdırılmaz
+ * top_k: Çekişme raporunda listelenecek hesap sayısı (sadece STATS=1 derlemesinde)
+ */
+typedef struct {
+    ExecMode mode;
+    WorkerEngine engine;
+    int num_workers;
+    int pin_workers;
+    MemoryPlacement memory_placement;
+    LockBackend lock_backend;
+    int lock_free_single;
+    int aggregate_deposits;
+    const char *accounts_file;
+    const char *transactions_file;
+    const char *journal_file;
+    int journal_group;
+    int journal_window_ms;
+    int recover;
+    const char *snapshot_file;
+    int snapshot_interval_ms;
+    int audit_interval_ms;
+    int retry_attempts;
+    int retry_backoff_ms;
+    const char *daemon_socket;
+    int bench;
+    int quiet;
+    int top_k;
+} Config;
+
+
+/*
+ * Komut satırı argümanlarını okuyup config yapısını doldurur
+ * Geçersiz bir argüman görülürse kullanım bilgisini yazar ve -1 döner
+ */
+int parse_config(int argc, char *argv[], Config *config);
+
+
+#endif  // CONFIG_H
@@ -0,0 +1,62 @@
+#ifndef CONTENTION_H      // Eğer CONTENTION_H tanımlı değilse
+#define CONTENTION_H      // CONTENTION_H'yi tanımla (header guard)
+
+#include "accounts.h"     // Account
+
+// 🔥 Hesap başına çekişme sayaçları
+// Sadece STATS=1 ile derlenen programda (BANK_STATS tanımlı) güncellenir; normal
+// derlemede kilit ve işlem kodundaki sayaç güncellemeleri tamamen derleme dışı kalır.
+
+#define CONTENTION_DEFAULT_TOP_K 10  // Raporda listelenen hesap sayısı
+
+/*
+ * Bir hesabın sayaçları (shared memory'de, tüm process'ler atomik arttırır)
+ * acquisitions: Hesabın kilidi kaç kez alındı
+ * contended: Kaç seferinde kilit dolu olduğu için beklendi
+ * wait_ns: Beklemede geçen toplam süre (toplu semop() beklemesi kümedeki her hesaba yazılır)
+ * failures: Hesaptan para çıkışı kaç kez başarısız oldu (yetersiz bakiye)
+ */
+typedef struct {
+    long acquisitions;
+    long contended;
+    long wait_ns;
+    long failures;
+} AccountStats;
+
+
+/*
+ * num_accounts hesap için sayaçları worker'ların paylaştığı bellekte (shared_alloc)
+ * sıfırlanmış olarak yaratır
+ * Dönüş: Sayaç dizisi (slot ile numaralanır), başarısızsa NULL
+ */
+AccountStats *account_stats_create(int num_accounts);
+
+
+// Sayaçların shared memory bağlantısını koparır
+void account_stats_destroy(AccountStats *stats);
+
+
+/*
+ * 📋 Toplam çekişmeyi ve bekleme süresine göre en sıcak top_k hesabı yazdırır
+ */
+void account_stats_report(const AccountStats *stats, const Account *accounts, int num_accounts, int top_k);
+
+
+// Kilit alındı (contended: 1 ise beklendi, wait_ns kadar sürdü)
+static inline void account_stats_acquired(AccountStats *stats, int slot, int contended, long wait_ns) {
+    AccountStats *s = &stats[slot];
+    __atomic_fetch_add(&s->acquisitions, 1, __ATOMIC_RELAXED);
+    if (contended) {
+        __atomic_fetch_add(&s->contended, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&s->wait_ns, wait_ns, __ATOMIC_RELAXED);
+    }
+}
+
+
+// Hesaptan para çıkışı yetersiz bakiye yüzünden başarısız oldu
+static inline void account_stats_failed(AccountStats *stats, int slot) {
+    __atomic_fetch_add(&stats[slot].failures, 1, __ATOMIC_RELAXED);
+}
+
+
+#endif  // CONTENTION_H
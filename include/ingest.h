@@ -0,0 +1,59 @@
+#ifndef INGEST_H          // Eğer INGEST_H tanımlı değilse
+#define INGEST_H          // INGEST_H'yi tanımla (header guard)
+
+#include <stddef.h>       // size_t
+#include "transactions.h" // Transaction
+
+/*
+ * 📄 mmap ile açılmış işlem dosyası üzerinde ilerleyen okuyucu
+ * Dosya bir kez belleğe eşlenir ve tek geçişte, sscanf kullanmadan parse edilir.
+ * İkili formattaki (binfmt.h) dosyalar otomatik tanınır; kayıtlar parse edilmeden kopyalanır.
+ * Okunmuş sayfalar periyodik olarak bırakılır; böylece çok büyük dosyalarda da
+ * bellek kullanımı sabit kalır.
+ * data / size: Eşlenmiş dosya ve boyutu
+ * pos: Sıradaki okunacak byte'ın konumu
+ * released: Bu konuma kadar olan sayfalar kernel'e geri verildi
+ * line: Hata mesajları için satır numarası
+ * binary: 1 ise dosya ikili formatta
+ * legs: Çok ayaklı işlemlerin ayaklarının yazılacağı dizi; çağıran her partiden önce
+ *       ayarlar ve en az max_count * MULTI_MAX_LEGS yer ayırır (NULL ise çok ayaklı
+ *       işlemler uyarı verilerek atlanır)
+ * num_legs: Son partide legs'e yazılan ayak sayısı
+ */
+typedef struct {
+    const char *data;
+    size_t size;
+    size_t pos;
+    size_t released;
+    long line;
+    int binary;
+    Leg *legs;
+    int num_legs;
+} TransactionReader;
+
+
+/*
+ * İşlem dosyasını açar ve belleğe eşler
+ * Boş dosya hata değildir (hiç işlem okunmaz)
+ * İkili dosyalarda başlık ve sağlama toplamı burada doğrulanır
+ * Dönüş: Başarılıysa 0, dosya açılamazsa veya bozuksa -1
+ */
+int reader_open(TransactionReader *reader, const char *filename);
+
+
+/*
+ * Sıradaki en fazla max_count işlemi out dizisine okur
+ * Boş satırlar atlanır; bozuk satırlar uyarı verilerek atlanır
+ * Çok ayaklı işlemin satırı: "3, HESAP:MİKTAR, HESAP:MİKTAR, ..." (negatif miktar borç);
+ * en az 2, en fazla MULTI_MAX_LEGS ayak, farklı hesaplar, toplam sıfır olmalıdır.
+ * Okunan işlemin from_account'u reader->legs içindeki ilk ayağı, to_account'u ayak sayısıdır
+ * Dönüş: Okunan işlem sayısı (max_count'tan azsa dosya bitmiştir)
+ */
+int reader_next_batch(TransactionReader *reader, Transaction *out, int max_count);
+
+
+// Eşlemeyi kaldırır
+void reader_close(TransactionReader *reader);
+
+
+#endif  // INGEST_H
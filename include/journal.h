@@ -0,0 +1,112 @@
+#ifndef JOURNAL_H         // Eğer JOURNAL_H tanımlı değilse
+#define JOURNAL_H         // JOURNAL_H'yi tanımla (header guard)
+
+#include <sys/types.h>    // pid_t
+#include "accounts.h"     // TransactionLog
+#include "account_table.h" // AccountTable
+#include "logring.h"      // LogRing
+
+// 📒 Journal dosyası: [BinaryHeader (magic "BKJL")][TransactionLog][TransactionLog]...
+// Sadece başarıyla uygulanan işlemler yazılır; çok ayaklı işlem başlık + ayak kayıtlarıdır. Dosya her çalıştırmada baştan yazılır
+// ve hesap dosyasından başlayan çalıştırmayı anlatır: hesap dosyası + journal = bakiyeler.
+#define JOURNAL_MAGIC "BKJL"
+
+#define JOURNAL_DEFAULT_GROUP 1024       // Bir fdatasync'e düşen en fazla kayıt sayısı
+#define JOURNAL_DEFAULT_WINDOW_MS 10     // Bekleyen kayıt en geç bu kadar ms sonra diske iner
+#define JOURNAL_RING_CAPACITY 65536      // Worker'lardan yazıcıya giden halkanın yuva sayısı
+
+/*
+ * Yazıcı process ile paylaşılan durum (shared memory'de)
+ * stop: 1 ise yazıcı halkada kalanları yazıp çıkar
+ * failed: Yazma veya fdatasync başarısız oldu (kayıtlar tüketilir ama diske inmez)
+ * records / syncs: Diske yazılan kayıt ve yapılan fdatasync sayısı; kayıtlar halka
+ *                  sırasıyla yazıldığı için records aynı zamanda diske inmiş konumdur
+ *                  (halkadaki ilk records kayıt fdatasync ile kalıcı)
+ * synced_seq: Her fdatasync'ten (veya hatadan) sonra artar; journal_wait_synced bunun
+ *             üzerinde uyur
+ */
+typedef struct {
+    int stop;
+    int failed;
+    int synced_seq;
+    long records;
+    long syncs;
+} JournalState;
+
+/*
+ * 🖋️ Açık journal
+ * ring: Worker'ların kayıt eklediği, tek okuyucusu yazıcı process olan halka
+ * state: Paylaşılan durum
+ * writer_pid: Kayıtları gruplar halinde dosyaya yazan ayrı process
+ * records / syncs: journal_close() sonrası diske yazılan kayıt ve fdatasync sayısı
+ */
+typedef struct {
+    LogRing *ring;
+    JournalState *state;
+    pid_t writer_pid;
+    long records;
+    long syncs;
+} Journal;
+
+
+/*
+ * Journal dosyasını yaratır (varsa sıfırlar) ve yazıcı process'i başlatır
+ * Worker'lar fork edilmeden önce çağrılmalıdır
+ * group_size: Bu kadar kayıt birikince yaz ve fdatasync yap
+ * window_ms: İlk bekleyen kayıttan bu kadar ms sonra grup dolmasa da yaz
+ * Dönüş: Başarılıysa 0, dosya açılamazsa veya fork başarısızsa -1
+ */
+int journal_open(Journal *journal, const char *filename, int group_size, int window_ms);
+
+
+/*
+ * Uygulanan bir işlemi journal'a ekler (birden fazla process aynı anda çağırabilir)
+ * Kayıt yazıcıya halka üzerinden gider; çağıran fdatasync'i beklemez
+ * Dönüş: Kaydın konumu + 1; journal_wait_synced(journal, dönüş) kayıt diske inince döner
+ */
+long journal_append(Journal *journal, int transaction_id, int type, int64_t from_account,
+                    int64_t to_account, int amount);
+
+
+/*
+ * Uygulanan çok ayaklı işlemi journal'a ekler: MULTI_LEG başlık kaydı (to_account ayak
+ * sayısı) ve ardından her ayak için bir LEG_RECORD kaydı (from_account hesap, amount
+ * işaretli miktar). Kayıtlar halkada ardışık yer alır, araya başka işlem girmez.
+ * Dönüş: Son ayak kaydının konumu + 1 (journal_append gibi)
+ */
+long journal_append_multi(Journal *journal, int transaction_id, const Leg *legs, int num_legs,
+                          int64_t first_debit, int total);
+
+
+/*
+ * ⏳ Halkadaki ilk position kayıt yazılıp fdatasync yapılana kadar bekler (group commit
+ * penceresi kadar sürebilir). Daemon cevabı göndermeden önce çağırır: istemciye başarılı
+ * denen işlem çökmeden sonra da journal'dadır.
+ * Dönüş: Kayıtlar diskteyse 0, yazıcı daha önce başarısız olduysa -1
+ */
+int journal_wait_synced(Journal *journal, long position);
+
+
+// Yazıcı bir yazma veya fdatasync hatası gördü mü? (sonraki kayıtlar diske inmez)
+int journal_failed(const Journal *journal);
+
+
+/*
+ * Yazıcıya kalan kayıtları diske yazdırır, çıkmasını bekler ve journal'ı kapatır
+ * Dönüş: Tüm kayıtlar diske indiyse 0, yazma hatası olduysa -1
+ */
+int journal_close(Journal *journal);
+
+
+/*
+ * 🔄 Kurtarma: journal'daki işlemleri hesap tablosuna tekrar uygular
+ * table hesap dosyasından veya snapshot'tan okunmuş başlangıç bakiyelerini içermelidir
+ * skip: Snapshot'a zaten dahil olan, atlanacak ilk kayıt sayısı (hesap dosyasında 0)
+ * Yarım yazılmış son kayıt ve ayakları tamamlanmamış son çok ayaklı işlem (çökme anında)
+ * uyarı verilerek atlanır; çok ayaklı işlem ya tamamen uygulanır ya hiç uygulanmaz
+ * Dönüş: Uygulanan kayıt sayısı, dosya okunamazsa veya bozuksa -1
+ */
+long journal_replay(const char *filename, AccountTable *table, long skip);
+
+
+#endif  // JOURNAL_H
@@ -0,0 +1,76 @@
+#ifndef LATENCY_H         // Eğer LATENCY_H tanımlı değilse
+#define LATENCY_H         // LATENCY_H'yi tanımla (header guard)
+
+#include <time.h>         // clock_gettime
+#include "locks.h"        // CACHE_LINE_SIZE
+
+// ⏱️ Benchmark ölçümleri (-b): işlem başına gecikme histogramı ve kilit bekleme süresi
+
+// 2'nin her kuvveti 2^LATENCY_SUB_BITS alt kovaya bölünür (en fazla %6.25 hata)
+#define LATENCY_SUB_BITS 4
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS (64 * LATENCY_SUB_BUCKETS)
+
+/*
+ * 📊 Log-lineer gecikme histogramı (nanosaniye)
+ * Her worker kendi histogramına yazar; sonuçlar çalışma bitince birleştirilir
+ * count / total_ns / max_ns: Ölçülen işlem sayısı, toplam ve en uzun süre
+ * lock_wait_ns: Kilit almak için geçen toplam süre
+ * buckets: Kova başına işlem sayısı
+ */
+typedef struct {
+    long count;
+    long total_ns;
+    long max_ns;
+    long lock_wait_ns;
+    long buckets[LATENCY_BUCKETS];
+} __attribute__((aligned(CACHE_LINE_SIZE))) LatencyHistogram;
+
+/*
+ * Ölçüm alanı (worker'ların paylaştığı bellekte, shared_alloc)
+ * num_slots: Histogram sayısı (pool modunda worker başına bir tane)
+ */
+typedef struct {
+    int num_slots;
+    LatencyHistogram slots[];
+} LatencyStats;
+
+
+/*
+ * num_slots histogramlık ölçüm alanını yaratır (segment hemen silinmek üzere işaretlenir)
+ * Dönüş: Ölçüm alanı, başarısızsa NULL
+ */
+LatencyStats *latency_stats_create(int num_slots);
+
+
+// Ölçüm alanının shared memory bağlantısını koparır
+void latency_stats_destroy(LatencyStats *stats);
+
+
+/*
+ * Bir işlemin süresini histograma ekler
+ * Birden fazla process aynı histograma yazabilir (fork modu), sayaçlar atomik arttırılır
+ */
+void latency_record(LatencyHistogram *histogram, long ns);
+
+
+// Tüm histogramları out'a toplar
+void latency_merge(const LatencyStats *stats, LatencyHistogram *out);
+
+
+/*
+ * Histogramdaki işlemlerin q kadarının (0..1) altında kaldığı süre (nanosaniye)
+ * Değer, kovanın orta noktasıdır
+ */
+long latency_percentile(const LatencyHistogram *histogram, double q);
+
+
+// Monoton saat (nanosaniye)
+static inline long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+
+#endif  // LATENCY_H
@@ -0,0 +1,110 @@
+#ifndef LOCKS_H           // Eğer LOCKS_H tanımlı değilse
+#define LOCKS_H           // LOCKS_H'yi tanımla (header guard)
+
+#include <stddef.h>         // size_t
+#include "contention.h"     // AccountStats (STATS=1)
+#include "account_table.h"  // AccountTable, AccountLock, CACHE_LINE_SIZE
+
+// 🔐 Hesap kilitleri için kullanılabilecek arka uçlar (backend)
+// LOCK_SEM: System V semaphore setleri, her sem_p / sem_v bir semop() sistem çağrısı
+// LOCK_FUTEX: Shared memory içindeki futex kelimesi, çekişme yoksa kernel'e hiç girmez
+// LOCK_NONE: Kilit yok; aynı anda çalışan işlemlerin ortak hesabı olmadığını
+//            zamanlayıcı garanti eder (-m sched)
+typedef enum {
+    LOCK_SEM,
+    LOCK_FUTEX,
+    LOCK_NONE
+} LockBackend;
+
+/*
+ * Kilit katmanının paylaşılan sayaçları (kilit alanının başında durur)
+ * semops_saved: Toplu semop() sayesinde yapılmayan sistem çağrısı sayısı
+ */
+typedef struct {
+    long semops_saved;
+} __attribute__((aligned(CACHE_LINE_SIZE))) LockCounters;
+
+/*
+ * Seçilen backend'e göre hesap kilitlerini temsil eden yapı
+ * Fork öncesi doldurulur; child process'ler kopyasını kullanır
+ * backend: LOCK_SEM, LOCK_FUTEX veya LOCK_NONE
+ * sem_ids / num_sem_sets: Semaphore setleri (sadece LOCK_SEM); bir set en fazla
+ *                          sems_per_set (kernel'in SEMMSL sınırı) semaphore taşır,
+ *                          hesap i'nin semaphore'u sem_ids[i / sems_per_set] setindedir
+ * locks: Shared memory'deki futex kilit dizisi (sadece LOCK_FUTEX)
+ * lines: LAYOUT=padded derlemesinde futex kilitleri hesap satırlarındadır, locks kullanılmaz
+ * counters: Shared memory'deki kilit sayaçları
+ * lock_free_single: 1 ise tek hesaplı işlemler (yatırma / çekme) kilit almaz,
+ *                   bakiyeyi atomik fetch-add / CAS ile değiştirir
+ * wait_ns: NULL değilse kilit almak için geçen süre buraya eklenir (benchmark, -b);
+ *          her process kendi kopyasında kendi sayacını gösterir
+ * stats: Hesap başına çekişme sayaçları (sadece STATS=1 derlemesinde, NULL olabilir)
+ */
+typedef struct {
+    LockBackend backend;
+    int *sem_ids;
+    int num_sem_sets;
+    int sems_per_set;
+    AccountLock *locks;
+#ifdef ACCOUNT_LAYOUT_PADDED
+    AccountLine *lines;
+#endif
+    LockCounters *counters;
+    int lock_free_single;
+    long *wait_ns;
+#ifdef BANK_STATS
+    AccountStats *stats;
+#endif
+} LockSet;
+
+
+/*
+ * max_accounts hesap için gereken kilit alanı boyutu (byte)
+ * Alan shared memory'de durur: önce LockCounters, arkasından AccountLock dizisi
+ * (LAYOUT=padded: sadece LockCounters, kilitler hesap satırlarındadır)
+ */
+size_t lock_area_size(int max_accounts);
+
+
+/*
+ * Tablodaki hesaplar için kilitleri hazırlar (hesaplar slot numarası ile kilitlenir)
+ * lock_area: lock_area_size() kadar, cache line hizalı shared memory alanı
+ * LOCK_SEM: SEMMSL sınırına göre gereken sayıda IPC_PRIVATE semaphore seti
+ *           yaratılır ve hepsi 1 yapılır (set başına tek semctl(SETALL))
+ * LOCK_FUTEX: alandaki tüm futex kilitleri açık duruma getirilir
+ * LOCK_NONE: hiçbir şey yaratılmaz, kilit fonksiyonları hiçbir şey yapmaz
+ * Dönüş: Başarılıysa 0, aksi halde -1
+ */
+int init_lock_set(LockSet *lock_set, LockBackend backend, void *lock_area, const AccountTable *table);
+
+
+/*
+ * Kilitlerin kullandığı kernel kaynaklarını siler (LOCK_SEM için semaphore setleri)
+ */
+void destroy_lock_set(LockSet *lock_set);
+
+
+// 🔒 Tek bir hesabı kilitler (backend'e göre sem_p veya futex)
+void lock_account(LockSet *lock_set, int slot);
+
+
+// 🔓 Tek bir hesabın kilidini açar
+void unlock_account(LockSet *lock_set, int slot);
+
+
+/*
+ * 🔒🔒 Birden fazla hesabı tek seferde kilitler (transfer ve çok ayaklı işlemler için)
+ * slots dizisi yerinde sıralanır ve tekrar eden slot'lar atılır; dönüş değeri
+ * kilitlenen farklı hesap sayısıdır ve unlock_account_set()'e aynen verilmelidir
+ * LOCK_SEM: aynı setteki hesaplar tek bir semop() çağrısıyla atomik olarak alınır;
+ *           farklı setler (ve SEM_BATCH_MAX'tan büyük kümeler) artan slot sırasıyla
+ * LOCK_FUTEX: hesaplar artan slot sırasıyla alınır (deadlock önleme)
+ */
+int lock_account_set(LockSet *lock_set, int *slots, int n);
+
+
+// 🔓🔓 lock_account_set() ile alınan kilitleri bırakır
+void unlock_account_set(LockSet *lock_set, const int *slots, int n);
+
+
+#endif  // LOCKS_H
@@ -0,0 +1,74 @@
+#ifndef LOGRING_H         // Eğer LOGRING_H tanımlı değilse
+#define LOGRING_H         // LOGRING_H'yi tanımla (header guard)
+
+#include "accounts.h"     // TransactionLog
+#include "locks.h"        // CACHE_LINE_SIZE
+
+/*
+ * 📜 Log halkası (ring buffer, shared memory'de)
+ * Yazan process'ler (worker'lar / child'lar) tail'i atomik arttırarak kendine bir
+ * yuva ayırır ve kaydı oraya yazar; kimse kilit almaz, kimse başkasını beklemez.
+ * Kaydın status alanı en son yazılır: LOG_EMPTY olmayan yuva okunmaya hazırdır.
+ * Okuyucu tek bir process'tir (ana process); head'i sadece o ilerletir.
+ * tail: Sıradaki ayrılacak yuva (yazanlar atomik arttırır)
+ * head: Sıradaki okunacak yuva (sadece okuyucu yazar)
+ * capacity: Yuva sayısı; okunmamış kayıt sayısı bunu geçmemelidir
+ * process_shared: 1 ise halka her zaman shared memory'dedir (log_ring_create_shared)
+ * tail ve head ayrı cache line'larda durur: yazanlar ile okuyucu birbirini yavaşlatmaz
+ */
+typedef struct {
+    long tail __attribute__((aligned(CACHE_LINE_SIZE)));
+    long head __attribute__((aligned(CACHE_LINE_SIZE)));
+    long capacity;
+    int process_shared;
+    TransactionLog entries[] __attribute__((aligned(CACHE_LINE_SIZE)));
+} LogRing;
+
+
+/*
+ * capacity yuvalık halkayı worker'ların paylaştığı bellekte yaratır (shared_alloc:
+ * IPC_PRIVATE segment, hemen silinmek üzere işaretlenir; -e threads ile process'e özel bellek)
+ * Dönüş: Halka, başarısızsa NULL
+ */
+LogRing *log_ring_create(long capacity);
+
+
+// capacity kayıtlık halkanın kapladığı alan (byte)
+size_t log_ring_size(long capacity);
+
+
+// Okuyucusu başka bir process olan halka (journal yazıcısı): -e threads ile de shared memory'dedir
+LogRing *log_ring_create_shared(long capacity);
+
+
+// Halkanın shared memory bağlantısını koparır
+void log_ring_destroy(LogRing *ring);
+
+
+/*
+ * Halkaya bir log kaydı ekler (birden fazla process aynı anda çağırabilir)
+ * Halka doluysa okuyucu yer açana kadar bekler
+ * Dönüş: Kaydın halkadaki konumu (ayrılma sırası, 0'dan başlar)
+ */
+long log_append(LogRing *ring, int transaction_id, int type, int64_t from_account,
+                int64_t to_account, int amount, int status);
+
+
+/*
+ * count kaydı halkada ardışık yuvalara ekler (tek atomik ayırma; başka bir yazanın
+ * kaydı araya giremez). records'ın status alanları kullanılır.
+ * Çok ayaklı işlemin journal'daki başlık + ayak kayıtları için
+ * Dönüş: İlk kaydın halkadaki konumu
+ */
+long log_append_group(LogRing *ring, const TransactionLog *records, int count);
+
+
+/*
+ * Sıradaki kaydı okur ve yuvasını boşaltır (sadece okuyucu çağırır)
+ * Kayıtlar ayrılma sırasıyla okunur; sıradaki yuva henüz yazılmadıysa beklemez
+ * Dönüş: 1 ise out dolduruldu, 0 ise okunacak hazır kayıt yok
+ */
+int log_ring_pop(LogRing *ring, TransactionLog *out);
+
+
+#endif  // LOGRING_H
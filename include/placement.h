@@ -0,0 +1,113 @@
+#ifndef PLACEMENT_H       // Eğer PLACEMENT_H tanımlı değilse
+#define PLACEMENT_H       // PLACEMENT_H'yi tanımla (header guard)
+
+#include <stddef.h>       // size_t
+#include "locks.h"        // CACHE_LINE_SIZE
+
+/*
+ * 📍 Worker'ların çekirdeklere ve belleğin NUMA node'larına yerleştirilmesi (-p, -N)
+ * -N, bellek yerel olsun diye worker'ları da sabitler (-p'yi açar).
+ * Topoloji /sys/devices/system/node'dan okunur; sadece process'in çalışabildiği CPU'lar
+ * (sched_getaffinity) ve bu CPU'ları olan node'lar kullanılır. Worker'lar node'lara
+ * ardışık bloklar halinde eşit dağıtılır ve node'un CPU'larına sırayla sabitlenir.
+ * Tek node'lu makinede (veya sysfs yoksa) bellek yerleşimi atlanır, sabitleme yine yapılır.
+ */
+
+// Desteklenen en büyük node numarası + 1 (mbind maskesi tek bir unsigned long)
+#define PLACEMENT_MAX_NODES 64
+
+/*
+ * Hesap ve log belleğinin node'lara dağılımı (-N)
+ * MEMORY_DEFAULT: Kernel'in varsayılanı (sayfa ona ilk dokunan CPU'nun node'unda)
+ * MEMORY_INTERLEAVE: Sayfalar node'lara sırayla dağıtılır
+ * MEMORY_PARTITION: Worker w'nun slot aralığının (shard w'nun hesapları) bakiyeleri ve
+ *                   kilitleri w'nun node'unda; indeks ve log halkası dağıtılır
+ *                   (yalnızca -m shard; diğer modlar işlemleri hesaba göre dağıtmaz)
+ */
+typedef enum {
+    MEMORY_DEFAULT,
+    MEMORY_INTERLEAVE,
+    MEMORY_PARTITION
+} MemoryPlacement;
+
+/*
+ * Worker başına işlem sayacı (kendi cache line'ında, sadece worker'ı yazar)
+ */
+typedef struct {
+    long transactions;
+} __attribute__((aligned(CACHE_LINE_SIZE))) WorkerCounter;
+
+/*
+ * Yerleşim planı (fork öncesi doldurulur, worker'lar kopyasını sadece okur)
+ * memory: Bellek yerleşimi
+ * num_nodes: CPU'su olan node sayısı; node_ids: node numaraları
+ * num_cpus / cpus / cpu_node: Çalışılabilen CPU'lar node sırasıyla ve node'larının
+ *                             node_ids içindeki yeri
+ * num_workers / worker_cpu / worker_node: Worker'ın CPU'su ve node'unun node_ids içindeki yeri
+ * counters: Worker başına işlem sayısı (shared_alloc, node başına verim raporu için)
+ */
+typedef struct {
+    MemoryPlacement memory;
+    int num_nodes;
+    int node_ids[PLACEMENT_MAX_NODES];
+    int num_cpus;
+    int *cpus;
+    int *cpu_node;
+    int num_workers;
+    int *worker_cpu;
+    int *worker_node;
+    WorkerCounter *counters;
+} Placement;
+
+
+/*
+ * Topolojiyi okur ve num_workers worker için CPU ve node seçer
+ * Dönüş: Başarılıysa 0, aksi halde -1
+ */
+int placement_init(Placement *placement, MemoryPlacement memory, int num_workers);
+
+
+// Dizileri ve sayaçları bırakır
+void placement_destroy(Placement *placement);
+
+
+/*
+ * Çağıran worker'ı (process veya thread) CPU'suna sabitler
+ * Başarısız olursa uyarı yazar ve sabitlemeden devam eder
+ */
+void placement_pin(const Placement *placement, int worker);
+
+
+/*
+ * Alanın sayfalarını tüm node'lara dağıtır (-N interleave ve partition)
+ * Bellek ayrıldıktan hemen sonra, sayfalara dokunulmadan çağrılır
+ * Tek node'da veya MEMORY_DEFAULT ile bir şey yapmaz
+ */
+void placement_interleave(const Placement *placement, void *area, size_t size);
+
+
+/*
+ * Slot başına eşit boyutlu elemanlardan oluşan alanı (bakiyeler, kilitler) yerleştirir
+ * MEMORY_PARTITION: worker w'nun slot aralığının sayfaları w'nun node'unda; aralıklar
+ * -m shard'daki gibi num_slots / num_workers (yukarı yuvarlanmış) genişliktedir
+ * MEMORY_INTERLEAVE: placement_interleave ile aynı
+ */
+void placement_place_slots(const Placement *placement, void *area, size_t size, int num_slots);
+
+
+/*
+ * Node başına worker'ları, CPU'ları, işlem sayısını ve verimi yazdırır
+ * run_ns: Çalışmanın süresi
+ */
+void placement_report(const Placement *placement, long run_ns);
+
+
+// Worker'ın bitirdiği işlemi sayar
+static inline void placement_count(Placement *placement, int worker) {
+    if (placement != NULL) {
+        placement->counters[worker].transactions++;
+    }
+}
+
+
+#endif  // PLACEMENT_H
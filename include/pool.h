@@ -0,0 +1,192 @@
+#ifndef POOL_H            // Eğer POOL_H tanımlı değilse
+#define POOL_H            // POOL_H'yi tanımla (header guard)
+
+#include "accounts.h"
+#include "locks.h"
+#include "logring.h"
+#include "snapshot.h"
+#include "latency.h"
+#include "shard.h"
+#include "placement.h"
+
+// Bir parçadaki (chunk) işlem sayısı; son parça hariç tüm parçalar tam doludur
+#ifndef CHUNK_SIZE
+#define CHUNK_SIZE 4096
+#endif
+
+/*
+ * Parçaların zamanlayıcı tarafından nasıl hazırlandığı (scheduler.h)
+ * SCHEDULE_NONE: Zamanlayıcı yok, işlemler hesap kilitleriyle korunur (-m pool)
+ * SCHEDULE_WAVES: Parça, ortak hesabı olmayan dalgalara bölünür (-m sched)
+ * SCHEDULE_TURNS: Her işlem, dokunduğu her hesapta kendi sırasını (turn) bekler (-m ordered)
+ */
+typedef enum {
+    SCHEDULE_NONE,
+    SCHEDULE_WAVES,
+    SCHEDULE_TURNS
+} ScheduleKind;
+
+/*
+ * Worker'ların nasıl çalıştığı (-e)
+ * ENGINE_PROCESSES: Her worker fork edilen bir process'tir; kuyruk, hesaplar ve loglar
+ *                   IPC_PRIVATE shared memory'dedir
+ * ENGINE_THREADS: Her worker ana process'in bir pthread'idir; aynı yapılar process'e özel
+ *                 bellektedir (shared_alloc), kilitler futex kelimeleridir
+ */
+typedef enum {
+    ENGINE_PROCESSES,
+    ENGINE_THREADS
+} WorkerEngine;
+
+// Bir parçanın ayak dizisinin boyutu: her işlem en fazla MULTI_MAX_LEGS ayaklı olabilir
+// (shared memory sayfaları dokunulunca ayrılır; çok ayaklı işlem yoksa bellek harcanmaz)
+#define CHUNK_LEGS (CHUNK_SIZE * MULTI_MAX_LEGS)
+
+// Aynı anda bellekte bulunabilecek parça sayısı (parse edilen + işlenen)
+// Bellek kullanımı dosya boyutundan bağımsız olarak CHUNK_SLOTS * CHUNK_SIZE ile sınırlıdır
+#ifndef CHUNK_SLOTS
+#define CHUNK_SLOTS 4
+#endif
+
+/*
+ * 📦 Bir parça işlem (shared memory'de)
+ * base_id: Parçadaki ilk işlemin ID'si (tekrar deneme parçalarında ilk işlemin kuyruktaki yeri)
+ * count: Parçadaki işlem sayısı
+ * span: Parçanın kapladığı işlem indeksi sayısı (publish_chunk atar); tekrar deneme
+ *       parçası sonraki parçalar CHUNK_SIZE sınırından başlasın diye hep CHUNK_SIZE
+ *       kaplar, worker'lar count'tan sonraki boş yerleri çalıştırmadan sayar
+ * retry: 1 ise tekrar deneme parçası (-r); işlem ID'leri ardışık değildir, ids'tedir
+ * done: Tamamlanan yer sayısı, span olunca parça biter (worker'lar atomik arttırır,
+ *       ana process bekler)
+ * txns / results: İşlemler ve sonuçları (log kayıtları LogRing'e yazılır)
+ * legs: Parçadaki çok ayaklı işlemlerin ayakları (txns[j].from_account ilk ayağın yeri)
+ * order / wave_gate: Sadece -m sched; çalıştırma sırasındaki k. işlem txns[order[k]]'dir
+ *                    ve queue->completed en az wave_gate[k] olunca başlar (scheduler.h)
+ * turn_slot / turn: Sadece -m ordered; işlem j, turn_slot[j][h] != -1 olan her hesapta
+ *                   queue->turns[turn_slot[j][h]] == turn[j][h] olunca başlar ve
+ *                   bitince sırayı bir arttırır
+ * leg_turn_slot / leg_turn: Sadece -m ordered; çok ayaklı işlemin sıraları turn_slot
+ *                   yerine ayaklarının yanında tutulur (legs ile aynı indeksler)
+ * aggregated / deposit_total: aggregated 1 ise (-d) yatırmalar ön toplanmıştır ve
+ *                   deposit_total[j] işlemin payıdır (aggregate.h; DEPOSIT_UNMERGED
+ *                   dışındaki yatırmalar process_deposit_run ile çalışır)
+ */
+typedef struct {
+    int base_id;
+    int count;
+    int span;
+    int done;
+    int retry;
+    Transaction txns[CHUNK_SIZE];
+    int ids[CHUNK_SIZE];
+    int results[CHUNK_SIZE];
+    int order[CHUNK_SIZE];
+    long wave_gate[CHUNK_SIZE];
+    int turn_slot[CHUNK_SIZE][2];
+    long turn[CHUNK_SIZE][2];
+    Leg legs[CHUNK_LEGS];
+    int leg_turn_slot[CHUNK_LEGS];
+    long leg_turn[CHUNK_LEGS];
+    int aggregated;
+    int deposit_total[CHUNK_SIZE];
+} Chunk;
+
+
+// Parçadaki offset. işlemin ID'si
+static inline int chunk_transaction_id(const Chunk *chunk, int offset) {
+    return chunk->retry ? chunk->ids[offset] : chunk->base_id + offset;
+}
+
+/*
+ * 📥 Worker'ların paylaştığı iş kuyruğu (shared memory'de durur)
+ * Ana process dosyayı parse ettikçe parçaları yayınlar, worker'lar ilk parça
+ * hazır olur olmaz çalışmaya başlar (parse bitmesini beklemezler).
+ * İşlem i her zaman chunks[(i / CHUNK_SIZE) % CHUNK_SLOTS] içindedir.
+ * claimed: Sıradaki alınacak işlem indeksi, worker'lar atomik olarak arttırır
+ * available: Şimdiye kadar yayınlanan toplam işlem sayısı
+ * finished: 1 ise dosya bitti, daha fazla parça gelmeyecek
+ * publish_seq: Her yayında artar; worker'lar bu futex kelimesinde uyur
+ * gate: Periyodik snapshot'lar için epoch kapısı (NULL ise kullanılmaz)
+ * stats: Benchmark ölçümleri, worker w slots[w]'ye yazar (NULL ise ölçüm yapılmaz)
+ * schedule: Parçaların zamanlayıcıda nasıl hazırlandığı; NONE dışında işlemler kilitsiz çalışır
+ * turns: Hesap başına sırası gelen işlem (sadece SCHEDULE_TURNS, zamanlayıcının shared memory'si)
+ * completed: Biten toplam işlem sayısı (sadece SCHEDULE_WAVES, dalga geçişleri için)
+ * shards: NULL değilse (-m shard) worker'lar shard'dır; claimed kullanılmaz, ana process
+ *         her işlemi publish_chunk içinde sahibi olan shard'ın kuyruğuna yazar
+ * engine: Worker'lar process mi thread mi? (start_worker_pool'dan önce atanır)
+ * threads: ENGINE_THREADS ile başlatılan worker'lar (wait_worker_pool bekler ve bırakır)
+ * placement: NULL değilse (-p / -N) worker w başlarken CPU'suna sabitlenir ve bitirdiği
+ *            işlemleri sayar (shard'lar sadece ana process'ten gelen işlemleri sayar)
+ */
+typedef struct {
+    long claimed;
+    long available;
+    int finished;
+    int publish_seq;
+    SnapshotGate *gate;
+    LatencyStats *stats;
+    ScheduleKind schedule;
+    long *turns;
+    ShardSet *shards;
+    WorkerEngine engine;
+    struct WorkerThread *threads;
+    Placement *placement;
+    long completed __attribute__((aligned(CACHE_LINE_SIZE)));
+    Chunk chunks[CHUNK_SLOTS];
+} WorkQueue;
+
+
+/*
+ * Kuyruğu boş hale getirir (fork öncesi ana process çağırır)
+ * Snapshot kapısı, ölçüm, zamanlayıcı, shard'lar veya yerleşim kullanılacaksa gate / stats /
+ * schedule / turns / shards / placement alanları bundan sonra, fork'tan önce atanır
+ */
+void work_queue_init(WorkQueue *queue);
+
+
+/*
+ * 👷 num_workers adet worker başlatır (queue->engine'e göre process veya thread)
+ * Her worker kuyruktan işlem indeksi çekip execute_transaction() çağırır, sonucu
+ * parçanın içine, log kaydını logs halkasına yazar. Dosya bitip kuyruk boşalınca çıkar.
+ * queue->shards varsa worker w shard w'dur: sadece kendi hesaplarına dokunur, işlemleri
+ * kendi kuyruklarından alır ve tüm işlemler bitince çıkar.
+ * Thread'ler, fork edilen process'ler gibi table ve locks'un kendi kopyasıyla çalışır
+ * (kopyalar sadece işlem epoch'unu ve ölçüm sayacını tutar, diziler ortaktır)
+ * Dönüş: Başlatılan worker sayısı (hiç başlatılamazsa 0)
+ */
+int start_worker_pool(WorkQueue *queue, int num_workers, AccountTable *table, LogRing *logs, LockSet *locks);
+
+
+/*
+ * Parse edilip doldurulmuş sıradaki parçayı worker'lara açar
+ * chunk: queue->chunks içinden sıradaki parça (base_id, txns ve legs doldurulmuş olmalı)
+ * Tekrar deneme parçası (retry 1) dosyanın ortasında da yayınlanabilir (-r, -m pool),
+ * ama son, yarım normal parçadan sonra yayınlanamaz
+ * queue->shards varsa işlemler sahibi olan shard'ların kuyruklarına yazılır (kuyruk
+ * doluysa yer açılana kadar beklenir). Ayakları birden fazla shard'a dağılan çok ayaklı
+ * işlem bir bariyerdir: önceki tüm işlemler bitince ilk ayağın shard'ına gönderilir ve o
+ * bitene kadar sonraki işlemler gönderilmez (shard'lar o sırada başka hesaba dokunmaz)
+ */
+void publish_chunk(WorkQueue *queue, Chunk *chunk, int count);
+
+
+/*
+ * Dosyanın bittiğini worker'lara bildirir (bekleyen worker'lar uyanıp çıkar)
+ */
+void finish_work_queue(WorkQueue *queue);
+
+
+/*
+ * Parçadaki tüm işlemler bitene kadar bekler
+ */
+void wait_chunk(Chunk *chunk);
+
+
+/*
+ * start_worker_pool() ile başlatılan worker'ların çıkmasını bekler
+ * Dönüş: Başarılıysa 0, wait / pthread_join başarısız olursa -1
+ */
+int wait_worker_pool(WorkQueue *queue, int num_started);
+
+
+#endif  // POOL_H
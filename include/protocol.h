@@ -0,0 +1,47 @@
+#ifndef PROTOCOL_H        // Eğer PROTOCOL_H tanımlı değilse
+#define PROTOCOL_H        // PROTOCOL_H'yi tanımla (header guard)
+
+#include <stdint.h>       // int64_t, uint32_t
+
+// 🔌 Daemon (-D) ile istemciler arasındaki ikili çerçeveler (Unix domain socket)
+// Bağlantı, uzunluk alanı olmayan sabit boyutlu çerçevelerden oluşan bir akıştır.
+// İstemci cevap beklemeden çok sayıda istek gönderebilir (pipelining); daemon
+// okuduğu tüm istekleri çalıştırır ve cevaplarını tek write() ile, istek sırasıyla yollar.
+// Aynı makinedeki process'ler arasında kullanıldığı için sayılar makinenin byte sırasındadır.
+
+/*
+ * İstek çerçevesi (25 byte)
+ * from_account / to_account: İşlemin hesapları (kullanılmayan -1)
+ * amount: Tutar
+ * tag: İstemcinin verdiği numara, cevapta aynen döner
+ * type: DEPOSIT, WITHDRAW veya TRANSFER (transactions.h)
+ */
+typedef struct __attribute__((packed)) {
+    int64_t from_account;
+    int64_t to_account;
+    int32_t amount;
+    uint32_t tag;
+    uint8_t type;
+} WireRequest;
+
+/*
+ * Cevap çerçevesi (9 byte)
+ * tag: İsteğin numarası
+ * transaction_id: Daemon'un işleme verdiği ID (journal'daki ID)
+ * status: LOG_SUCCESS veya LOG_FAILED (accounts.h)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t tag;
+    int32_t transaction_id;
+    uint8_t status;
+} WireReply;
+
+// Bir okumada işlenen en fazla istek sayısı (cevaplar da en fazla bu kadar toplanır)
+#define WIRE_BATCH 1024
+
+// İstemcinin cevabını beklemeden gönderebileceği en fazla istek sayısı; daha fazlası
+// okunmamış cevaplar socket tamponunu doldurduğunda iki tarafı da kilitleyebilir
+#define WIRE_MAX_PIPELINE 8192
+
+
+#endif  // PROTOCOL_H
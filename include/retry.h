@@ -0,0 +1,121 @@
+#ifndef RETRY_H           // Eğer RETRY_H tanımlı değilse
+#define RETRY_H           // RETRY_H'yi tanımla (header guard)
+
+#include "accounts.h"       // Transaction, Leg
+#include "account_table.h"  // AccountTable
+#include "latency.h"        // LatencyHistogram, now_ns
+
+// 🔁 Ertelenmiş tekrar deneme kuyruğu (-r, ana process'te çalışır)
+// Başarısız işlemler hemen tekrar denenmez: para çıkan hesabın bakiyesi işlemi
+// karşılayacak kadar artana kadar (ör. hesaba yatırma veya transfer gelene kadar)
+// kuyrukta bekler. Bakiyesi yeten işlemler worker'lara verilir: -m pool'da parçalar
+// emekliye ayrıldıkça çalışmanın içinde, diğer modlarda çalışmadan sonra turlar halinde.
+// Tekrar başarısız olan işlem backoff süresi dolunca yeniden denenir.
+
+// Tekrar başarısız olan işlemin ilk bekleme süresi (ms); her denemede iki katına çıkar
+#define RETRY_DEFAULT_BACKOFF_MS 0
+
+// Backoff en fazla 2^RETRY_MAX_BACKOFF_SHIFT katına çıkar
+#define RETRY_MAX_BACKOFF_SHIFT 10
+
+/*
+ * Kuyrukta bekleyen bir işlem
+ * transaction_id / txn: İşlem (parça geri kullanıldığı için kopyalanır)
+ * legs: Çok ayaklı işlemin ayaklarının kopyası (txn.from_account 0), diğer türlerde NULL
+ * slot: Para çıkan (çok ayaklıda ilk borçlu) hesabın slot'u; çok ayaklı işlem her borçlu
+ *       ayağının bakiyesini bekler
+ * attempts: Yapılan tekrar deneme sayısı
+ * failed_ns: İlk başarısızlığın görüldüğü an (tekrar deneme gecikmesi buradan ölçülür)
+ * due_ns: Backoff; işlem bu andan önce denenmez
+ */
+typedef struct {
+    int transaction_id;
+    Transaction txn;
+    Leg *legs;
+    int slot;
+    int attempts;
+    long failed_ns;
+    long due_ns;
+} RetryItem;
+
+/*
+ * Tekrar deneme kuyruğu ve sonuçları
+ * table: Hesap ID → slot ve bakiyeler
+ * max_attempts: İşlem başına en fazla tekrar deneme sayısı
+ * backoff_ms: Tekrar başarısız olan işlemin ilk bekleme süresi
+ * items / count / capacity: Bekleyen işlemler (ID sırasıyla)
+ * taken / num_taken: Son retry_queue_take() ile verilen işlemlerin items içindeki yerleri
+ * parked: Kuyruğa giren işlem sayısı
+ * not_retryable: Yatırma, bilinmeyen hesap veya işlem türü yüzünden kuyruğa alınmayan işlemler
+ * rounds / attempts / succeeded / exhausted: Tur, deneme, başarılı deneme ve deneme
+ *                                            hakkı biten işlem sayıları
+ * latency: Başarılı tekrar denemelerin ilk başarısızlıktan itibaren gecikmesi
+ */
+typedef struct {
+    const AccountTable *table;
+    int max_attempts;
+    int backoff_ms;
+    RetryItem *items;
+    int count;
+    int capacity;
+    int *taken;
+    int num_taken;
+    long parked;
+    long not_retryable;
+    long rounds;
+    long attempts;
+    long succeeded;
+    long exhausted;
+    LatencyHistogram latency;
+} RetryQueue;
+
+
+/*
+ * Boş kuyruk hazırlar
+ * max_attempts: İşlem başına en fazla tekrar deneme sayısı (en az 1)
+ * backoff_ms: Tekrar başarısız olan işlemin ilk bekleme süresi (ms)
+ */
+void retry_queue_init(RetryQueue *queue, const AccountTable *table, int max_attempts, int backoff_ms);
+
+
+// Kuyruğun belleğini serbest bırakır
+void retry_queue_destroy(RetryQueue *queue);
+
+
+/*
+ * Başarısız işlemi kuyruğa ekler (işlemler ID sırasıyla eklenmelidir)
+ * Yatırma, bilinmeyen hesap ve bilinmeyen işlem türü bakiye değişince düzelmez;
+ * bunlar kuyruğa alınmaz, not_retryable olarak sayılır
+ * legs: İşlemin okunduğu ayak dizisi (sadece MULTI_LEG; ayaklar kopyalanır)
+ * failed_ns: Başarısızlığın görüldüğü an (now_ns)
+ */
+void retry_queue_park(RetryQueue *queue, int transaction_id, const Transaction *txn, const Leg *legs,
+                      long failed_ns);
+
+
+/*
+ * Sıradaki turun işlemlerini seçer: para çıkan hesabının bakiyesi işlemi karşılayan
+ * ve backoff süresi dolmuş işlemler, ID sırasıyla, en fazla max tane
+ * Bakiyeler kilitsiz okunur: worker'lar çalışırken bakiye sadece bir ipucudur, işlem
+ * kilit altında yine kontrol edilir
+ * txns / ids: Seçilen işlemler ve ID'leri
+ * legs: Seçilen çok ayaklı işlemlerin ayakları (en az max * MULTI_MAX_LEGS yer;
+ *       txns[k].from_account ilk ayağın yeri, parçalardaki gibi)
+ * wait: 1 ise bakiyesi yeten ama backoff'u dolmamış işlemler için süre dolana kadar
+ *       uyur (worker'lar çalışmıyorken); 0 ise hemen döner
+ * Dönüş: Seçilen işlem sayısı; 0 ise şu an bakiyesi yeten (wait 1: hiçbir bekleyen
+ *        işlemin bakiyesi yetmiyor) işlem yok
+ */
+int retry_queue_take(RetryQueue *queue, Transaction *txns, int *ids, Leg *legs, int max, int wait);
+
+
+/*
+ * Son turun sonuçlarını işler (results[k], retry_queue_take'in k. işleminin sonucu)
+ * Başarılı işlemler kuyruktan çıkar; başarısızlar deneme hakkı varsa backoff ile
+ * kuyrukta kalır, yoksa exhausted olarak çıkar
+ * take ile settle arasında sadece retry_queue_park çağrılabilir (seçilenlerin yeri değişmez)
+ */
+void retry_queue_settle(RetryQueue *queue, const int *results);
+
+
+#endif  // RETRY_H
@@ -0,0 +1,72 @@
+#ifndef SCHEDULER_H       // Eğer SCHEDULER_H tanımlı değilse
+#define SCHEDULER_H       // SCHEDULER_H'yi tanımla (header guard)
+
+#include "account_table.h"  // AccountTable
+#include "pool.h"           // Chunk, CHUNK_SIZE
+
+/*
+ * 🌊 Çakışma farkında zamanlayıcı (-m sched / -m ordered, ana process'te çalışır)
+ * Her iki türde de her hesabın işlemleri girdi sırasıyla çalışır; bu yüzden sonuç,
+ * dosyayı sırayla tek tek çalıştırmakla aynıdır ve işlemler kilitsiz çalışır.
+ * SCHEDULE_WAVES: Her parça yayınlanmadan önce dalgalara (wave) bölünür: aynı
+ *   dalgadaki işlemlerin ortak hesabı yoktur. Bir işlem, dokunduğu hesapların
+ *   parçadaki son işleminden bir sonraki dalgaya konur.
+ * SCHEDULE_TURNS: İşlemler girdi sırasıyla çalışır; her işlem dokunduğu her hesapta
+ *   bir sıra numarası (turn) alır ve sadece o hesapların önceki işlemlerini bekler.
+ *   Dalga sınırı yoktur: yavaş bir işlem, hesapları ortak olmayan işlemleri durdurmaz.
+ * kind: SCHEDULE_WAVES veya SCHEDULE_TURNS
+ * table: Hesap ID → slot
+ * last_wave / stamp: Slot başına, hesabın bu parçadaki son dalgası (stamp == epoch ise geçerli)
+ * epoch: Parça sayacı; dizileri her parçada sıfırlamamak için
+ * wave_of / wave_start / wave_next: Parça içi geçici diziler (işlemin dalgası,
+ *                                    dalganın başı, dalgaya sıradaki yerleştirme yeri)
+ * issued: Slot başına, şimdiye kadar dağıtılan sıra numarası sayısı (sadece TURNS)
+ * turns: Slot başına, sırası gelen işlem; worker'lar arttırır (sadece TURNS, shared_alloc)
+ * depth: Slot başına, hesapta biten en uzun bağımlılık zincirinin uzunluğu (sadece TURNS)
+ * waves / transactions: Toplam dalga ve işlem sayısı (rapor için)
+ * longest_chain: Birbirini beklemek zorunda olan en uzun işlem zinciri (sadece TURNS, rapor için)
+ */
+typedef struct {
+    ScheduleKind kind;
+    const AccountTable *table;
+    int *last_wave;
+    int *stamp;
+    int epoch;
+    int wave_of[CHUNK_SIZE];
+    int wave_start[CHUNK_SIZE + 1];
+    int wave_next[CHUNK_SIZE];
+    long *issued;
+    long *turns;
+    int *depth;
+    long waves;
+    long transactions;
+    long longest_chain;
+} Scheduler;
+
+
+/*
+ * Zamanlayıcıyı hesap tablosu için hazırlar (worker'lar fork edilmeden önce)
+ * Dönüş: Başarılıysa 0, SCHEDULE_TURNS için shared memory yaratılamazsa -1
+ */
+int scheduler_init(Scheduler *scheduler, ScheduleKind kind, const AccountTable *table);
+
+
+// Zamanlayıcının dizilerini serbest bırakır
+void scheduler_destroy(Scheduler *scheduler);
+
+
+/*
+ * Parçanın ilk count işlemini hazırlar (publish_chunk'tan önce çağrılır)
+ * SCHEDULE_WAVES:
+ *   chunk->order: Çalıştırma sırası → parçadaki yer (dalga dalga)
+ *   chunk->wave_gate: Çalıştırma sırası → o işlem başlamadan önce bitmiş olması
+ *                     gereken toplam işlem sayısı (kendi dalgasının başı, global)
+ * SCHEDULE_TURNS:
+ *   chunk->turn_slot / turn: İşlemin dokunduğu farklı hesaplar ve her birindeki sırası
+ *   (çok ayaklı işlemde chunk->leg_turn_slot / leg_turn)
+ * chunk->base_id ve chunk->legs (-d ile chunk->deposit_total de) doldurulmuş olmalıdır
+ */
+void schedule_chunk(Scheduler *scheduler, Chunk *chunk, int count);
+
+
+#endif  // SCHEDULER_H
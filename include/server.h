@@ -0,0 +1,64 @@
+#ifndef SERVER_H          // Eğer SERVER_H tanımlı değilse
+#define SERVER_H          // SERVER_H'yi tanımla (header guard)
+
+#include "account_table.h"  // AccountTable
+#include "locks.h"          // LockSet, CACHE_LINE_SIZE
+#include "latency.h"        // LatencyHistogram
+#include "journal.h"        // Journal
+#include "protocol.h"       // WireRequest, WireReply
+
+// 🛰️ Daemon modu (-D): hesap segmenti bellekte kalır, işlemler Unix domain socket'ten gelir
+// Ana process bağlantıları kabul eder ve her bağlantı için bir process fork eder; bağlantı
+// process'leri istekleri hesap kilitleriyle, batch modundaki worker'lar gibi çalıştırır.
+
+/*
+ * Bağlantı process'lerinin paylaştığı sayaçlar (IPC_PRIVATE shared memory'de)
+ * next_id: Sıradaki işlem ID'si (tüm bağlantılarda tek, atomik arttırılır)
+ * failed: Başarısız işlem sayısı
+ */
+typedef struct {
+    long next_id;
+    long failed;
+} __attribute__((aligned(CACHE_LINE_SIZE))) ServerState;
+
+
+/*
+ * SIGINT ve SIGTERM için durma bayrağını kuran handler'ı yükler
+ * Journal yazıcısı ve bağlantı process'leri fork edilmeden önce çağrılmalıdır:
+ * handler fork ile miras kalır, terminalden gelen Ctrl-C kimseyi öldürmez ve
+ * ana process her şeyi sırayla kapatır
+ */
+void server_install_signals(void);
+
+
+// Durma sinyali geldi mi?
+int server_stopping(void);
+
+
+/*
+ * Socket'i path'te yaratıp dinlemeye başlar (eski socket dosyası silinir)
+ * Dönüş: Dinleyen socket, başarısızsa -1
+ */
+int server_listen(const char *path);
+
+
+/*
+ * Sayaçlar için shared memory yaratır (segment hemen silinmek üzere işaretlenir)
+ * Dönüş: Sayaçlar, başarısızsa NULL
+ */
+ServerState *server_state_create(void);
+
+
+/*
+ * Bir bağlantıyı istemci kapatana veya durma sinyali gelene kadar sunar (bağlantı process'i)
+ * Okunan tüm tam istekler sırayla çalıştırılır, cevapları tek write() ile gönderilir
+ * journal: NULL değilse (-j) cevaplar, işlemlerin journal kayıtları fdatasync ile diske
+ *          indikten sonra gönderilir; yazıcı başarısız olduysa bağlantı cevapsız kapatılır
+ * histogram: NULL değilse işlem süreleri buraya yazılır (-b)
+ * Dönüş: Çalıştırılan işlem sayısı, socket veya journal hatasında -1
+ */
+long server_serve(int fd, AccountTable *table, LockSet *locks, ServerState *state, Journal *journal,
+                  LatencyHistogram *histogram);
+
+
+#endif  // SERVER_H
@@ -0,0 +1,150 @@
+#ifndef SHARD_H           // Eğer SHARD_H tanımlı değilse
+#define SHARD_H           // SHARD_H'yi tanımla (header guard)
+
+#include "accounts.h"       // Transaction
+#include "account_table.h"  // AccountTable
+#include "locks.h"          // CACHE_LINE_SIZE
+
+// 🧩 Hesapların worker'lara bölünmesi (-m shard)
+// Her worker (shard) ardışık bir slot aralığının tek sahibidir; bakiyelere sadece
+// sahibi dokunduğu için kilit alınmaz. İşlemler ana process'ten, farklı shard'lara
+// giden transferlerin alacak yarısı diğer shard'lardan tek üreticili / tek tüketicili
+// (SPSC) kuyruklarla gelir.
+
+// Kuyruk başına mesaj sayısı (2'nin kuvveti)
+#ifndef SHARD_QUEUE_SIZE
+#define SHARD_QUEUE_SIZE 1024
+#endif
+
+/*
+ * 📮 Tek üreticili / tek tüketicili mesaj kuyruğu (shared memory'de)
+ * Mesaj, işlemin global indeksidir; işlemin kendisi parçada (Chunk) durur
+ * head / tail_cache: Tüketicinin cache line'ı (okunan mesaj sayısı, tail'in son görülen değeri)
+ * tail / head_cache: Üreticinin cache line'ı (yazılan mesaj sayısı, head'in son görülen değeri)
+ * Karşı tarafın sayacı sadece önbellekteki değer yetmediğinde okunur
+ */
+typedef struct {
+    long head __attribute__((aligned(CACHE_LINE_SIZE)));
+    long tail_cache;
+    long tail __attribute__((aligned(CACHE_LINE_SIZE)));
+    long head_cache;
+    long items[SHARD_QUEUE_SIZE] __attribute__((aligned(CACHE_LINE_SIZE)));
+} ShardQueue;
+
+/*
+ * Bir shard'ın paylaşılan durumu (kendi cache line'ında)
+ * signal: Futex kelimesi; boşta kalan shard bunun üzerinde uyur
+ * sleeping: 1 ise shard uyumak üzere, üreticiler mesajdan sonra uyandırır
+ * settled: Bu shard'da tamamlanan işlem sayısı (çıkış kontrolü için)
+ */
+typedef struct {
+    int signal;
+    int sleeping;
+    long settled;
+} __attribute__((aligned(CACHE_LINE_SIZE))) ShardState;
+
+/*
+ * Shard'ların tamamı (fork öncesi doldurulur, child'lar kopyasını kullanır)
+ * table: Hesap ID → slot (ana process işlemleri yönlendirirken kullanır)
+ * num_shards: Shard (worker) sayısı
+ * span: Shard başına slot sayısı; slot s'nin sahibi s / span
+ * state: Shard başına durum
+ * inbox: Ana process → shard kuyrukları (num_shards tane)
+ * links: Shard → shard kuyrukları; links[from * num_shards + to]
+ * Üçü de aynı paylaşılan alandadır (shared_alloc), alan state ile başlar
+ */
+typedef struct {
+    const AccountTable *table;
+    int num_shards;
+    int span;
+    ShardState *state;
+    ShardQueue *inbox;
+    ShardQueue *links;
+} ShardSet;
+
+
+/*
+ * num_shards shard'lık kuyrukları tek bir shared memory segmentinde yaratır
+ * (segment hemen silinmek üzere işaretlenir)
+ * Dönüş: Başarılıysa 0, aksi halde -1
+ */
+int shard_set_create(ShardSet *set, int num_shards, const AccountTable *table);
+
+
+// Kuyrukların shared memory bağlantısını koparır
+void shard_set_destroy(ShardSet *set);
+
+
+/*
+ * İşlemin gönderileceği shard: para çıkan hesabın sahibi (yatırmada hedef hesabın,
+ * çok ayaklı işlemde ilk ayağın hesabının)
+ * Bilinmeyen hesaplı işlemler bakiyeye dokunmadan başarısız olur, shard 0'a gider
+ * legs: Parçanın ayak dizisi (sadece MULTI_LEG)
+ * spans: NULL değilse, ayakları birden fazla shard'a dağılan çok ayaklı işlemde 1 olur
+ */
+int shard_home(const ShardSet *set, const Transaction *txn, const Leg *legs, int *spans);
+
+
+/*
+ * shard'a gelen ve henüz okunmamış mesaj var mı? (tüm giriş kuyrukları)
+ */
+int shard_pending(const ShardSet *set, int shard);
+
+
+/*
+ * Mesaj yazıldıktan sonra çağrılır; shard uyuyorsa uyandırır
+ * (uyumuyorsa sistem çağrısı yapılmaz)
+ */
+void shard_notify(ShardSet *set, int shard);
+
+
+/*
+ * 💤 Boştaki shard'ı yeni mesaj gelene veya *stop 1 olana kadar uyutur
+ * Uyumadan önce kuyruklar tekrar kontrol edildiği için mesaj kaçmaz
+ */
+void shard_idle(ShardSet *set, int shard, const int *stop);
+
+
+// Slot'un sahibi olan shard
+static inline int shard_of(const ShardSet *set, int slot) {
+    return slot / set->span;
+}
+
+
+/*
+ * Kuyruğa mesaj ekler (sadece üretici çağırır)
+ * Dönüş: 1 ise eklendi, 0 ise kuyruk dolu
+ */
+static inline int shard_queue_push(ShardQueue *queue, long message) {
+    long tail = queue->tail;
+    if (tail - queue->head_cache == SHARD_QUEUE_SIZE) {
+        queue->head_cache = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+        if (tail - queue->head_cache == SHARD_QUEUE_SIZE) {
+            return 0;
+        }
+    }
+    queue->items[tail & (SHARD_QUEUE_SIZE - 1)] = message;
+    __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);  // Mesaj yazıldıktan sonra görünür
+    return 1;
+}
+
+
+/*
+ * Kuyruktan mesaj alır (sadece tüketici çağırır)
+ * Dönüş: 1 ise message dolduruldu, 0 ise kuyruk boş
+ */
+static inline int shard_queue_pop(ShardQueue *queue, long *message) {
+    long head = queue->head;
+    if (head == queue->tail_cache) {
+        queue->tail_cache = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+        if (head == queue->tail_cache) {
+            return 0;
+        }
+    }
+    *message = queue->items[head & (SHARD_QUEUE_SIZE - 1)];
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);  // Yer üreticiye geri verilir
+    return 1;
+}
+
+
+#endif  // SHARD_H
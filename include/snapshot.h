@@ -0,0 +1,172 @@
+#ifndef SNAPSHOT_H        // Eğer SNAPSHOT_H tanımlı değilse
+#define SNAPSHOT_H        // SNAPSHOT_H'yi tanımla (header guard)
+
+#include <stdint.h>       // uint32_t, int64_t
+#include <time.h>         // struct timespec
+#include "accounts.h"     // Account
+#include "account_table.h"  // AccountTable
+#include "journal.h"      // Journal
+#include "locks.h"        // CACHE_LINE_SIZE
+
+// 📸 Snapshot: hesap dizisinin ikili hesap dosyası (binfmt.h, magic "BKAC") olarak kopyası
+// Başlıktaki aux alanı snapshot'a dahil olan journal kaydı sayısıdır; kurtarmada
+// journal'ın bu kadar kaydı atlanır.
+
+#define SNAPSHOT_DEFAULT_INTERVAL_MS 1000  // Çalışma sırasında snapshot aralığı
+
+/*
+ * Worker'ın "işlem çalıştırıyorum" bayrağı (her worker kendi cache line'ında)
+ * busy: 0 ise worker işlemde değil, değilse çalıştırdığı işlemin epoch'u + 1
+ */
+typedef struct {
+    int busy;
+    char pad[CACHE_LINE_SIZE - sizeof(int)];
+} __attribute__((aligned(CACHE_LINE_SIZE))) WorkerFlag;
+
+/*
+ * 🚪 Epoch geçiş kapısı (shared memory'de)
+ * Worker'lar her işlemden önce kapıdan girer ve işlemin epoch'unu alır, sonra çıkar.
+ * Kesit alan process epoch'u ilerletir ve sadece önceki epoch'ta başlamış işlemlerin
+ * bitmesini bekler; yeni işlemler yeni epoch ile hiç beklemeden başlar. Hesaplar, sürümlü
+ * bakiyeler sayesinde (account_version_touch) worker'lar çalışırken epoch sınırındaki
+ * halleriyle okunur. Normal çalışmada giriş / çıkış sadece worker'ın kendi bayrağına yazar.
+ * Kilitsiz yatırma / çekmede (-c) aynı hesaba aynı anda birden fazla işlem yazabildiği
+ * için kapı eskisi gibi kopyalama süresince kapatılır.
+ * closed: 1 ise kapı kapalı, yeni işlem başlamasın
+ * epoch: Yeni başlayan işlemlerin epoch'u (sadece kesit alan process arttırır)
+ * draining: 1 ise kesit alan process önceki epoch'un işlemlerini bekliyor
+ * blocking: 1 ise kesitler kapı kapatılarak alınır (-c)
+ * workers: Worker başına bir bayrak
+ */
+typedef struct {
+    int closed __attribute__((aligned(CACHE_LINE_SIZE)));
+    int epoch;
+    int draining;
+    int blocking;
+    int num_workers;
+    WorkerFlag workers[];
+} SnapshotGate;
+
+/*
+ * Periyodik snapshot'ları alan taraf (ana process)
+ * filename: Snapshot dosyası
+ * interval_ms: Çalışma sırasında iki snapshot arası süre (0: sadece başta ve sonda)
+ * table: Kopyalanacak shared memory'deki hesap tablosu
+ * journal: Açık journal (NULL olabilir); snapshot'a journal konumu yazılır
+ * copy: Hesapların kesitteki hallerinin kopyalandığı tampon
+ * last: Son snapshot zamanı
+ * taken / max_pause_us: Yazılan snapshot sayısı ve worker'ların kapıda en uzun bekleme süresi
+ */
+typedef struct {
+    const char *filename;
+    int interval_ms;
+    const AccountTable *table;
+    const Journal *journal;
+    Account *copy;
+    struct timespec last;
+    long taken;
+    long max_pause_us;
+} Snapshotter;
+
+/*
+ * 🧮 Periyodik denetim (-A): çalışma sırasında tutarlı kesitteki bakiyelerin toplamı
+ * Snapshot ile aynı kesiti kullanır ama dosya yazmaz; sadece para çeken veya yatıran
+ * işlem yoksa toplam her denetimde aynı çıkmalıdır.
+ * interval_ms: İki denetim arası süre
+ * table: Toplanan shared memory'deki hesap tablosu
+ * last: Son denetim zamanı
+ * taken: Denetim sayısı
+ * min_total / max_total / last_total: Görülen en küçük, en büyük ve son toplam
+ * max_us: En uzun denetim süresi (bekleme + okuma)
+ * max_pause_us: Worker'ların kapıda en uzun bekleme süresi (sadece -c)
+ */
+typedef struct {
+    int interval_ms;
+    const AccountTable *table;
+    struct timespec last;
+    long taken;
+    int64_t min_total;
+    int64_t max_total;
+    int64_t last_total;
+    long max_us;
+    long max_pause_us;
+} Auditor;
+
+
+/*
+ * num_workers worker için kapıyı worker'ların paylaştığı bellekte yaratır (shared_alloc)
+ * blocking: 1 ise kesitler kapı kapatılarak alınır (kilitsiz yatırma / çekme, -c)
+ * Dönüş: Kapı, başarısızsa NULL
+ */
+SnapshotGate *snapshot_gate_create(int num_workers, int blocking);
+
+
+// Kapının shared memory bağlantısını koparır
+void snapshot_gate_destroy(SnapshotGate *gate);
+
+
+/*
+ * worker numaralı worker bir işleme başlamadan önce çağırır
+ * Kapı kapalıysa açılmasını bekler; epoch ilerlerken beklemez
+ * Dönüş: İşlemin epoch'u (worker bunu tablonun write_epoch'una yazar)
+ */
+int snapshot_gate_enter(SnapshotGate *gate, int worker);
+
+
+// İşlem bittikten sonra çağrılır
+void snapshot_gate_leave(SnapshotGate *gate, int worker);
+
+
+/*
+ * Snapshot alanı hazırlar (dosyaya henüz bir şey yazmaz)
+ */
+void snapshotter_init(Snapshotter *snapshots, const char *filename, int interval_ms,
+                      const AccountTable *table, const Journal *journal);
+
+
+// Periyodik snapshot zamanı geldi mi? (interval_ms 0 ise hiçbir zaman)
+int snapshot_due(const Snapshotter *snapshots);
+
+
+/*
+ * Tutarlı bir snapshot alıp dosyaya yazar
+ * gate: Worker'lar çalışıyorsa onların kapısı, çalışmıyorsa NULL
+ * Hesaplar worker'lar çalışırken kopyalanır. Journal varsa kapı, sadece epoch geçişi ve
+ * journal konumu okunurken (yarım kalmış işlemler bitene kadar) kapalı kalır: konumdan
+ * önceki kayıtlar tam olarak kesitteki işlemlerdir. -c'de kapı kopyalama süresince kapalıdır.
+ * Dosya yazma ve fsync her zaman worker'lar çalışırken yapılır
+ * Dönüş: Başarılıysa 0, dosya yazılamazsa -1
+ */
+int snapshot_take(Snapshotter *snapshots, SnapshotGate *gate);
+
+
+/*
+ * Snapshot dosyasını okur (mmap, parse yok)
+ * accounts: Hesap sayısı kadar malloc ile ayrılan dizi (çağıran free eder)
+ * journal_records: NULL değilse snapshot'a dahil olan journal kaydı sayısı
+ * Dönüş: Okunan hesap sayısı, dosya bozuksa -1, dosya yoksa BINARY_NOT_BINARY
+ */
+int snapshot_load(const char *filename, Account **accounts, long *journal_records);
+
+
+// Tamponu bırakır
+void snapshotter_destroy(Snapshotter *snapshots);
+
+
+// Denetimleri hazırlar (interval_ms 0 ise hiç denetim yapılmaz)
+void auditor_init(Auditor *audits, int interval_ms, const AccountTable *table);
+
+
+// Denetim zamanı geldi mi?
+int audit_due(const Auditor *audits);
+
+
+/*
+ * Tutarlı kesitteki bakiyelerin toplamını alır ve istatistiklere ekler
+ * gate: Worker'lar çalışıyorsa onların kapısı, çalışmıyorsa NULL
+ * Dönüş: Toplam
+ */
+int64_t audit_take(Auditor *audits, SnapshotGate *gate);
+
+
+#endif  // SNAPSHOT_H
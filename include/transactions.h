@@ -3,12 +3,19 @@
 
 // Hesap ve işlem log tanımları bu dosyada kullanılacağı için accounts.h dosyası dahil ediliyor
 #include "accounts.h"
+#include "account_table.h"
+#include "locks.h"
+#include "logring.h"
+#include "journal.h"
 
 
 // 💳 İşlem türleri (Transaction Types) için sabitler tanımlanıyor
 #define DEPOSIT 0              // Para yatırma işlemi
 #define WITHDRAW 1             // Para çekme işlemi
 #define TRANSFER 2             // Para transferi işlemi
+#define MULTI_LEG 3            // Çok ayaklı işlem: ayakların hepsi uygulanır ya da hiçbiri (bkz. Leg)
+#define LEG_RECORD 4           // İkili dosyada / journal'da çok ayaklı işlemin bir ayağı (tek başına işlem değil)
+#define UNKNOWN_TYPE 255       // Log kaydında: dosyadaki bilinmeyen işlem türü (yazdırılmaz)
 
 // ✔️ İşlem sonucu sabitleri
 #define SUCCESS 0              // İşlem başarılı
@@ -17,14 +24,24 @@
 
 /*
  *  Para yatırma işlemini gerçekleştiren fonksiyonun bildirimi
- * accounts: Paylaşımlı bellek üzerindeki hesap dizisi
- * logs: İşlem geçmişini tutan shared memory dizisi
- * account_id: Hangi hesaba yatırılacak?
+ * table: Paylaşımlı bellek üzerindeki hesap tablosu (hesap dizisi + ID indeksi)
+ * logs: Log kaydının ekleneceği shared memory'deki log halkası
+ * account_id: Hangi hesaba yatırılacak? (tabloda yoksa işlem FAILURE olur)
  * amount: Ne kadar yatırılacak?
  * transaction_id: Bu işlemin ID'si
- * sem_id: Semaphore set ID’si (kilitleme için)
+ * locks: Hesap kilitleri (semaphore veya futex backend'i)
  */
-int process_deposit(Account *accounts, TransactionLog *logs, int account_id, int amount, int transaction_id, int sem_id);
+int process_deposit(AccountTable *table, LogRing *logs, int64_t account_id, int amount, int transaction_id, LockSet *locks);
+
+
+/*
+ * ➕ Ön toplanmış yatırma serisinin bir yatırması (-d, bkz. aggregate.h)
+ * amount: Bu yatırmanın kendi miktarı (log kaydına yazılır)
+ * total: DEPOSIT_FOLDED ise bakiyeye dokunulmaz; değilse serinin lideridir ve bakiyeye
+ *        serinin toplamı eklenir, journal'a da toplam tek kayıt olarak yazılır
+ * Hesabın var olduğu ön toplamada kontrol edilmiştir; her zaman SUCCESS döner
+ */
+int process_deposit_run(AccountTable *table, LogRing *logs, int64_t account_id, int amount, int total, int transaction_id, LockSet *locks);
 
 
 /*
@@ -32,37 +49,90 @@ int process_deposit(Account *accounts, TransactionLog *logs, int account_id, int
  * Aynı parametreler kullanılır ama bu sefer hesaptan para düşer
  * Bakiye yeterli değilse FAILURE döner
  */
-int process_withdraw(Account *accounts, TransactionLog *logs, int account_id, int amount, int transaction_id, int sem_id);
+int process_withdraw(AccountTable *table, LogRing *logs, int64_t account_id, int amount, int transaction_id, LockSet *locks);
 
 
 /*
  * 🔁 Transfer işlemini gerçekleştiren fonksiyonun bildirimi
  * from_account → to_account hesabına belirtilen miktarı aktarır
  * Hem iki hesabı kilitler, hem de log kaydı oluşturur
- * Deadlock önlemek için küçük account ID'yi önce kilitler
+ * Deadlock önlemek için dizide önde olan (küçük slot'lu) hesabı önce kilitler
+ */
+int process_transfer(AccountTable *table, LogRing *logs, int64_t from_account, int64_t to_account, int amount, int transaction_id, LockSet *locks);
+
+
+/*
+ * ✂️ Transferin iki yarısı (-m shard): hesaplar farklı shard'lardaysa kaynak hesabın
+ * sahibi borç yarısını, hedef hesabın sahibi alacak yarısını çalıştırır; her hesaba
+ * sadece sahibi dokunduğu için kilit alınmaz
+ * process_transfer_debit: Parayı kaynak hesaptan düşer; bakiye yetmiyorsa veya hesap
+ *                         yoksa FAILURE log kaydını yazar ve FAILURE döner (alacak gönderilmez)
+ * process_transfer_credit: Parayı hedef hesaba ekler, SUCCESS log kaydını ve journal
+ *                          kaydını yazar; sadece başarılı borçtan sonra çağrılır
+ */
+int process_transfer_debit(AccountTable *table, LogRing *logs, int64_t from_account, int64_t to_account, int amount, int transaction_id, LockSet *locks);
+int process_transfer_credit(AccountTable *table, LogRing *logs, int64_t from_account, int64_t to_account, int amount, int transaction_id);
+
+
+/*
+ * 🧾 Çok ayaklı işlemi gerçekleştiren fonksiyonun bildirimi
+ * legs / num_legs: Ayaklar (negatif miktar borç, pozitif alacak; toplamı sıfır,
+ *                  her hesap en fazla bir kez — okuyucu bunu garanti eder)
+ * Tüm hesaplar tek bir kilit seti olarak alınır (sıralı, deadlock oluşmaz); bakiyeler
+ * değişmeden önce her borcun karşılandığı kontrol edilir. Bir hesap yoksa veya bir
+ * borç karşılanmıyorsa hiçbir bakiye değişmez ve FAILURE döner.
+ * Log kaydı: from_account ilk borçlu hesap, to_account ayak sayısı, amount toplam borç
+ * Journal açıksa işlem başlık + ayak kayıtları olarak ardışık yazılır
+ */
+int process_multi_leg(AccountTable *table, LogRing *logs, const Leg *legs, int num_legs, int transaction_id, LockSet *locks);
+
+
+/*
+ * 🔀 İşlem türüne göre doğru fonksiyonu çağıran ortak dağıtıcı
+ * Hem fork modunda (child process) hem de pool modunda (worker) kullanılır
+ * txn->type: DEPOSIT, WITHDRAW, TRANSFER veya MULTI_LEG
+ * legs: İşlemin okunduğu parçanın ayak dizisi (sadece MULTI_LEG; NULL ise çok ayaklı
+ *       işlem desteklenmiyor demektir ve işlem FAILURE olur, ör. daemon)
+ * Bilinmeyen bir işlem türünde UNKNOWN_TYPE log kaydı yazar ve FAILURE döner
+ * (her işlem tam olarak bir log kaydı üretir)
+ * Journal açıksa başarılı işlemler journal'a da eklenir
+ */
+int execute_transaction(AccountTable *table, LogRing *logs, const Transaction *txn, const Leg *legs, int transaction_id, LockSet *locks);
+
+
+/*
+ * 📒 execute_transaction() başarılı işlemleri bu journal'a da yazar (NULL: journal yok)
+ * Worker / child process'ler fork edilmeden önce çağrılmalıdır
+ */
+void set_transaction_journal(Journal *journal);
+
+
+/*
+ * Çağıran process'in journal'a eklediği son kaydın konumu + 1 (hiç eklemediyse 0)
+ * journal_wait_synced(journal, konum) bu process'in tüm kayıtları diske inince döner
  */
-int process_transfer(Account *accounts, TransactionLog *logs, int from_account, int to_account, int amount, int transaction_id, int sem_id);
+long transaction_journal_position(void);
 
 
 /*
- * 📄 İşlem dosyasını okuyan fonksiyon
+ * 📄 İşlem dosyasının tamamını belleğe okuyan fonksiyon (fork modu için)
  * filename: Okunacak dosya adı (örneğin transactions.txt)
- * Okunan işlemler bellekte 4 ayrı diziye atanır:
- * t_type[]        → işlem türü
- * from_acc[]      → gönderici hesap
- * to_acc[]        → alıcı hesap (deposit/withdraw’da -1 olabilir)
- * amount[]        → miktar
+ * transactions: malloc ile ayrılan Transaction dizisi (çağıran free eder)
+ * legs: Çok ayaklı işlemlerin ayakları için malloc ile ayrılan dizi (çağıran free eder)
+ * Pool modu dosyayı parça parça okur, bu fonksiyonu kullanmaz
+ * Dönüş: Okunan işlem sayısı, dosya açılamazsa -1
  */
-int read_transactions(const char *filename, int **t_type, int **from_acc, int **to_acc, int **amount);
+int read_transactions(const char *filename, Transaction **transactions, Leg **legs);
 
 
 /*
- * Başlangıçta hesapları dosyadan okuyan ve accounts dizisini dolduran fonksiyon
- * filename: Hesap bilgilerinin bulunduğu dosya (örneğin accounts.txt)
- * accounts: Shared memory’deki hesap dizisi
- * max_accounts: Maksimum kaç hesap destekleniyor?
+ * Başlangıçta hesapları dosyadan okuyan fonksiyon
+ * filename: Hesap bilgilerinin bulunduğu dosya (örneğin accounts.txt, metin veya ikili)
+ * accounts: Hesap sayısı kadar malloc ile ayrılan dizi (çağıran free eder)
+ * Hesap sayısı sınırı yoktur; shared memory okunan sayıya göre boyutlandırılır
+ * Dönüş: Okunan hesap sayısı (boş dosyada 0), dosya açılamazsa veya bozuksa -1
  */
-int initialize_accounts(const char *filename, Account *accounts, int max_accounts);
+int load_accounts(const char *filename, Account **accounts);
 
 
 #endif  // TRANSACTIONS_H
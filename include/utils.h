@@ -11,6 +11,10 @@
 #include <sys/shm.h>      // Shared memory (paylaşımlı bellek) işlemleri
 #include <sys/sem.h>      // Semaphore işlemleri
 #include <errno.h>        // Hata numaralarına erişmek için (errno)
+#include <sys/syscall.h>  // syscall(SYS_futex, ...)
+#include <linux/futex.h>  // FUTEX_WAIT, FUTEX_WAKE
+#include <sched.h>        // sched_yield
+#include <sys/mman.h>     // mmap (shared_alloc, -e threads)
 
 
 // ⛓️ Semaphore işlemlerinde kullanılan union semun yapısı
@@ -45,4 +49,72 @@ int sem_p(int sem_id, int sem_num);
 int sem_v(int sem_id, int sem_num);
 
 
+// Tek bir semop() çağrısında uygulanabilecek en fazla işlem sayısı
+// (Linux'ta SEMOPM; eski çekirdeklerde varsayılan 32 olduğu için güvenli değer)
+#define SEM_BATCH_MAX 32
+
+
+// 🔒🔒 Toplu P Operasyonu
+// sem_nums dizisindeki n semaphore'un hepsini TEK bir semop() ile atomik olarak azaltır
+// Ya hepsi birden alınır ya da hiçbiri alınmadan beklenir (kısmi kilit tutulmaz)
+// n en fazla SEM_BATCH_MAX olabilir, aynı semaphore iki kez verilmemelidir
+int sem_p_batch(int sem_id, const int *sem_nums, int n);
+
+
+// 🔒🔒 Beklemeden Toplu P Operasyonu
+// Semaphore'ların hepsi hemen alınabiliyorsa alır ve 0 döner; biri bile
+// beklemeyi gerektiriyorsa hiçbirini almadan -1 döner (errno EAGAIN)
+int sem_try_p_batch(int sem_id, const int *sem_nums, int n);
+
+
+// 🔓🔓 Toplu V Operasyonu
+// sem_nums dizisindeki n semaphore'u tek bir semop() ile arttırır
+int sem_v_batch(int sem_id, const int *sem_nums, int n);
+
+
+
+// 💤 Futex bekleme
+// *addr hâlâ expected değerindeyse process kernel'de uyutulur
+// Değer farklıysa hemen döner (kayıp uyandırma olmaz)
+int futex_wait(int *addr, int expected);
+
+
+// ⏰ Futex uyandırma
+// addr üzerinde bekleyen en fazla count process'i uyandırır
+int futex_wake(int *addr, int count);
+
+
+// 🧠 Worker'ların paylaştığı bellek
+// Varsayılan: IPC_PRIVATE bir shared memory segmenti; segment hemen silinmek üzere
+// işaretlenir, fork edilen worker'lar bağlı kalır, son process ayrılınca kernel temizler.
+// set_private_memory(1) sonrasında (-e threads) process'e özel anonim bellek (mmap);
+// kernel'de IPC nesnesi oluşmaz. Bellek her iki durumda da sıfırlanmış gelir.
+// what: Hata mesajında belleğin adı
+// Dönüş: Bellek, başarısızsa NULL
+void *shared_alloc(size_t size, const char *what);
+
+
+// shared_alloc() ile alınan belleği bırakır
+void shared_free(void *area);
+
+
+// Her zaman IPC_PRIVATE shared memory: başka bir process'in de okuduğu alanlar için
+// (ör. journal yazıcı process'i), -e threads ile de paylaşılır
+void *shm_alloc(size_t size, const char *what);
+void shm_free(void *area);
+
+
+// 1 ise shared_alloc() process'e özel bellek verir (worker'lar aynı process'in thread'leri)
+// Bellek ayrılmadan önce bir kez çağrılır
+void set_private_memory(int private_memory);
+
+
+// ⏳ Spin döngülerinde CPU'ya "bekliyorum" ipucu verir (x86'da pause komutu)
+static inline void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+
 #endif  // UTILS_H
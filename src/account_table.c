@@ -0,0 +1,113 @@
+#include "../include/account_table.h"  // AccountTable, AccountIndex
+#include <stdio.h>                      // fprintf
+#include <string.h>                     // memset
+
+// Doluluk en fazla 2/3 olacak şekilde 2'nin kuvveti yuva sayısı
+static uint64_t index_capacity(int num_accounts) {
+    uint64_t needed = (uint64_t)num_accounts + num_accounts / 2 + 1;
+    uint64_t capacity = 16;
+    while (capacity < needed) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+size_t account_index_size(int num_accounts) {
+    return index_capacity(num_accounts) * sizeof(IndexEntry);
+}
+
+size_t account_lines_size(int num_accounts) {
+#ifdef ACCOUNT_LAYOUT_PADDED
+    return (size_t)num_accounts * sizeof(AccountLine);
+#else
+    (void)num_accounts;
+    return 0;
+#endif
+}
+
+size_t account_versions_size(int num_accounts) {
+#ifdef ACCOUNT_LAYOUT_PADDED
+    (void)num_accounts;
+    return 0;
+#else
+    return (size_t)num_accounts * sizeof(int);
+#endif
+}
+
+int account_table_init(AccountTable *table, Account *accounts, int num_accounts, void *index_area,
+                       void *lines_area, void *versions_area) {
+    uint64_t capacity = index_capacity(num_accounts);
+    table->accounts = accounts;
+    table->num_accounts = num_accounts;
+    table->index.entries = (IndexEntry *)index_area;
+    table->index.mask = capacity - 1;
+#ifdef ACCOUNT_LAYOUT_PADDED
+    // Bakiyeler kendi satırlarına taşınır; kilitleri init_lock_set() açar
+    table->lines = (AccountLine *)lines_area;
+    for (int slot = 0; slot < num_accounts; slot++) {
+        table->lines[slot].balance = accounts[slot].balance;
+        table->lines[slot].lock.state = 0;
+        table->lines[slot].epoch = 0;
+        table->lines[slot].epoch_balance = 0;
+    }
+    (void)versions_area;
+#else
+    (void)lines_area;
+    // Etiketler sıfırdan başlar (dosyadan gelen değer ne olursa olsun); kenardaki bakiyeler
+    // sadece etiketlenen hesaplarda okunur
+    table->epoch_balances = (int *)versions_area;
+    for (int slot = 0; slot < num_accounts; slot++) {
+        accounts[slot].epoch = 0;
+    }
+#endif
+    table->write_epoch = 0;
+
+    // Tüm yuvalar boş (slot = -1)
+    memset(index_area, 0xff, capacity * sizeof(IndexEntry));
+
+    for (int slot = 0; slot < num_accounts; slot++) {
+        int64_t account_id = accounts[slot].account_id;
+        uint64_t pos = account_hash(account_id) & table->index.mask;
+        while (table->index.entries[pos].slot != -1) {
+            if (table->index.entries[pos].account_id == account_id) {
+                fprintf(stderr, "Duplicate account ID %lld in accounts file\n", (long long)account_id);
+                return -1;
+            }
+            pos = (pos + 1) & table->index.mask;
+        }
+        table->index.entries[pos].account_id = account_id;
+        table->index.entries[pos].slot = slot;
+        table->index.entries[pos].reserved = 0;
+    }
+    return 0;
+}
+
+void account_table_copy(const AccountTable *table, Account *out) {
+    memcpy(out, table->accounts, (size_t)table->num_accounts * sizeof(Account));
+    for (int slot = 0; slot < table->num_accounts; slot++) {
+#ifdef ACCOUNT_LAYOUT_PADDED
+        out[slot].balance = table->lines[slot].balance;
+#endif
+        out[slot].epoch = 0;  // Etiket sadece shared memory'de anlamlı
+    }
+}
+
+int64_t account_table_cut(const AccountTable *table, int epoch, Account *out) {
+    int64_t total = 0;
+    for (int slot = 0; slot < table->num_accounts; slot++) {
+        // Önce bakiye, sonra etiket (seqlock okuyucusu gibi): bakiyenin yeni değeri
+        // görüldüyse etiketin yeni değeri de görünür ve kenardaki bakiye kullanılır
+        int balance = account_read_balance(table, slot);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(account_epoch(table, slot), __ATOMIC_ACQUIRE) == epoch) {
+            balance = *account_epoch_balance(table, slot);
+        }
+        total += balance;
+        if (out != NULL) {
+            out[slot].account_id = table->accounts[slot].account_id;
+            out[slot].balance = balance;
+            out[slot].epoch = 0;
+        }
+    }
+    return total;
+}
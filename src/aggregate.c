@@ -0,0 +1,81 @@
+#include "../include/aggregate.h"     // DepositAggregator
+#include "../include/transactions.h"  // DEPOSIT, WITHDRAW, TRANSFER, MULTI_LEG
+#include <limits.h>                   // INT_MAX
+#include <stdlib.h>                   // calloc, free
+
+void deposit_aggregator_init(DepositAggregator *aggregator, const AccountTable *table) {
+    int n = table->num_accounts > 0 ? table->num_accounts : 1;
+    aggregator->table = table;
+    aggregator->run_last = (int *)calloc(n, sizeof(int));
+    aggregator->stamp = (int *)calloc(n, sizeof(int));  // 0: hiçbir partide görülmedi
+    aggregator->epoch = 0;
+    aggregator->folded = 0;
+    aggregator->runs = 0;
+}
+
+void deposit_aggregator_destroy(DepositAggregator *aggregator) {
+    free(aggregator->run_last);
+    free(aggregator->stamp);
+}
+
+// Hesabın açık serisini kapatır (bilinmeyen hesap için bir şey yapmaz)
+static void close_run(DepositAggregator *aggregator, int64_t account_id) {
+    int slot = account_table_find(aggregator->table, account_id);
+    if (slot != -1) {
+        aggregator->stamp[slot] = aggregator->epoch;
+        aggregator->run_last[slot] = -1;
+    }
+}
+
+// Yatırmayı hesabın açık serisine ekler veya yeni bir seri başlatır
+// Dönüş: 1 ise yatırma seriye girdi (totals[j] dolduruldu)
+static int join_run(DepositAggregator *aggregator, const Transaction *txns, int j, int *totals) {
+    const Transaction *txn = &txns[j];
+    if (txn->amount <= 0) {
+        return 0;
+    }
+    int slot = account_table_find(aggregator->table, txn->to_account);
+    if (slot == -1) {
+        return 0;  // Bilinmeyen hesap: işlem normal çalışıp FAILURE olur
+    }
+
+    int last = aggregator->stamp[slot] == aggregator->epoch ? aggregator->run_last[slot] : -1;
+    if (last != -1 && totals[last] <= INT_MAX - txn->amount) {
+        // Önceki lider katlanır; iki yatırmalı seri ilk kez oluşuyorsa bir güncelleme kazanıldı
+        aggregator->runs += totals[last] == txns[last].amount;
+        aggregator->folded++;
+        totals[j] = totals[last] + txn->amount;
+        totals[last] = DEPOSIT_FOLDED;
+    } else {
+        totals[j] = txn->amount;
+    }
+    aggregator->stamp[slot] = aggregator->epoch;
+    aggregator->run_last[slot] = j;
+    return 1;
+}
+
+void aggregate_deposits(DepositAggregator *aggregator, const Transaction *txns, const Leg *legs,
+                        int count, int *totals) {
+    aggregator->epoch++;
+    for (int j = 0; j < count; j++) {
+        const Transaction *txn = &txns[j];
+        totals[j] = DEPOSIT_UNMERGED;
+        if (txn->type == DEPOSIT && join_run(aggregator, txns, j, totals)) {
+            continue;
+        }
+
+        // Hesaba dokunan diğer her işlem, seriden sonra gelenlerin toplamı görmesi için seriyi kapatır
+        if (txn->type == MULTI_LEG) {
+            for (int k = 0; k < txn->to_account; k++) {
+                close_run(aggregator, legs[txn->from_account + k].account_id);
+            }
+            continue;
+        }
+        if (txn->type == WITHDRAW || txn->type == TRANSFER) {
+            close_run(aggregator, txn->from_account);
+        }
+        if (txn->type == DEPOSIT || txn->type == TRANSFER) {
+            close_run(aggregator, txn->to_account);
+        }
+    }
+}
@@ -0,0 +1,157 @@
+#include "../include/binfmt.h"   // BinaryHeader, BinaryChecksum
+#include <stdio.h>                // fprintf, perror
+#include <stdlib.h>               // malloc
+#include <string.h>               // memcmp, memcpy
+#include <fcntl.h>                // open
+#include <unistd.h>               // close, read, fsync, unlink
+#include <sys/mman.h>             // mmap, munmap
+#include <sys/stat.h>             // fstat
+
+void binary_checksum_init(BinaryChecksum *checksum) {
+    checksum->sum1 = 0;
+    checksum->sum2 = 0;
+}
+
+void binary_checksum_update(BinaryChecksum *checksum, const void *data, size_t size) {
+    const uint32_t *words = (const uint32_t *)data;
+    size_t count = size / sizeof(uint32_t);
+    uint64_t sum1 = checksum->sum1;
+    uint64_t sum2 = checksum->sum2;
+
+    // sum2 sıraya duyarlıdır: yer değiştiren kayıtlar da yakalanır
+    for (size_t i = 0; i < count; i++) {
+        sum1 += words[i];
+        sum2 += sum1;
+    }
+
+    checksum->sum1 = sum1;
+    checksum->sum2 = sum2;
+}
+
+uint64_t binary_checksum_final(const BinaryChecksum *checksum) {
+    return (checksum->sum2 << 32) ^ checksum->sum1;
+}
+
+int is_binary_file(const void *data, size_t size, const char *magic) {
+    return size >= sizeof(BinaryHeader) && memcmp(data, magic, 4) == 0;
+}
+
+int binary_validate(const void *data, size_t size, const char *magic, uint32_t record_size, const char *filename) {
+    const BinaryHeader *header = (const BinaryHeader *)data;
+
+    if (!is_binary_file(data, size, magic)) {
+        fprintf(stderr, "%s: not a binary %s file\n", filename,
+                strcmp(magic, BINARY_MAGIC_ACCOUNTS) == 0 ? "accounts" : "transactions");
+        return -1;
+    }
+    if (header->version != BINARY_FORMAT_VERSION) {
+        fprintf(stderr, "%s: unsupported binary format version %u (expected %d)\n",
+                filename, header->version, BINARY_FORMAT_VERSION);
+        return -1;
+    }
+    if (header->record_size != record_size) {
+        fprintf(stderr, "%s: record size %u does not match this build (%u)\n",
+                filename, header->record_size, record_size);
+        return -1;
+    }
+    if (size - sizeof(BinaryHeader) != header->record_count * record_size) {
+        fprintf(stderr, "%s: file size does not match record count %llu (truncated?)\n",
+                filename, (unsigned long long)header->record_count);
+        return -1;
+    }
+
+    BinaryChecksum checksum;
+    binary_checksum_init(&checksum);
+    binary_checksum_update(&checksum, (const char *)data + sizeof(BinaryHeader), size - sizeof(BinaryHeader));
+    if (binary_checksum_final(&checksum) != header->checksum) {
+        fprintf(stderr, "%s: checksum mismatch, file is corrupted\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+int read_binary_accounts(const char *filename, Account **accounts, uint32_t *aux) {
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        return BINARY_NOT_BINARY;  // Metin okuyucu hata mesajını verecek
+    }
+
+    // Önce sadece başlığa bak: metin dosyalarını mmap etmeye gerek yok
+    BinaryHeader header;
+    if (read(fd, &header, sizeof(header)) != sizeof(header) ||
+        memcmp(header.magic, BINARY_MAGIC_ACCOUNTS, 4) != 0) {
+        close(fd);
+        return BINARY_NOT_BINARY;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        perror("fstat failed for accounts file");
+        close(fd);
+        return -1;
+    }
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror("mmap failed for accounts file");
+        return -1;
+    }
+
+    if (binary_validate(data, st.st_size, BINARY_MAGIC_ACCOUNTS, sizeof(Account), filename) == -1) {
+        munmap(data, st.st_size);
+        return -1;
+    }
+
+    int account_count = (int)header.record_count;
+
+    // Kayıtlar Account yapısıyla aynı: parse yok, doğrudan kopyala
+    *accounts = (Account *)malloc((account_count > 0 ? account_count : 1) * sizeof(Account));
+    memcpy(*accounts, (const char *)data + sizeof(BinaryHeader), account_count * sizeof(Account));
+
+    if (aux != NULL) {
+        *aux = header.aux;
+    }
+
+    munmap(data, st.st_size);
+    return account_count;
+}
+
+int write_binary_accounts(const char *filename, const Account *accounts, int count, uint32_t aux) {
+    char tmp_name[4096];
+    snprintf(tmp_name, sizeof(tmp_name), "%s.tmp", filename);
+
+    BinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BINARY_MAGIC_ACCOUNTS, 4);
+    header.version = BINARY_FORMAT_VERSION;
+    header.record_size = sizeof(Account);
+    header.aux = aux;
+    header.record_count = count;
+    BinaryChecksum checksum;
+    binary_checksum_init(&checksum);
+    binary_checksum_update(&checksum, accounts, count * sizeof(Account));
+    header.checksum = binary_checksum_final(&checksum);
+
+    FILE *out = fopen(tmp_name, "wb");
+    if (out == NULL) {
+        perror("Error opening accounts output file");
+        return -1;
+    }
+    if (fwrite(&header, sizeof(header), 1, out) != 1 ||
+        fwrite(accounts, sizeof(Account), count, out) != (size_t)count ||
+        fflush(out) != 0 || fsync(fileno(out)) == -1) {
+        perror("Error writing accounts file");
+        fclose(out);
+        unlink(tmp_name);
+        return -1;
+    }
+    fclose(out);
+
+    // Eski dosyanın yerine atomik olarak geç
+    if (rename(tmp_name, filename) == -1) {
+        perror("rename failed for accounts file");
+        unlink(tmp_name);
+        return -1;
+    }
+    return 0;
+}
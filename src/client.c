@@ -0,0 +1,100 @@
+#include "../include/client.h"   // BankClient
+#include <stdio.h>                // perror, fprintf
+#include <string.h>               // memset, memcpy, memmove, strlen
+#include <errno.h>                // errno, EINTR
+#include <unistd.h>               // read, write, close
+#include <sys/socket.h>           // socket, connect
+#include <sys/un.h>               // sockaddr_un
+
+int bank_client_connect(BankClient *client, const char *path) {
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Socket path is too long: %s\n", path);
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    client->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client->fd == -1) {
+        perror("socket failed");
+        return -1;
+    }
+    if (connect(client->fd, (struct sockaddr *)&address, sizeof(address)) == -1) {
+        perror("Error connecting to daemon");
+        close(client->fd);
+        return -1;
+    }
+    client->next_tag = 0;
+    client->out_count = 0;
+    client->in_bytes = 0;
+    client->in_pos = 0;
+    return 0;
+}
+
+long bank_client_submit(BankClient *client, const Transaction *txn) {
+    if (client->out_count == WIRE_BATCH && bank_client_flush(client) == -1) {
+        return -1;
+    }
+    WireRequest *request = &client->out[client->out_count++];
+    request->from_account = txn->from_account;
+    request->to_account = txn->to_account;
+    request->amount = txn->amount;
+    request->tag = client->next_tag++;
+    request->type = (uint8_t)txn->type;
+    return request->tag;
+}
+
+int bank_client_flush(BankClient *client) {
+    const char *p = (const char *)client->out;
+    size_t size = (size_t)client->out_count * sizeof(WireRequest);
+    while (size > 0) {
+        ssize_t written = write(client->fd, p, size);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Error sending requests");
+            return -1;
+        }
+        p += written;
+        size -= (size_t)written;
+    }
+    client->out_count = 0;
+    return 0;
+}
+
+int bank_client_receive(BankClient *client, WireReply *reply) {
+    if (client->out_count > 0 && bank_client_flush(client) == -1) {
+        return -1;
+    }
+
+    // Tamponda tam cevap yoksa yarım kalanı başa taşı ve okunabilen her şeyi oku
+    while (client->in_bytes - client->in_pos < sizeof(WireReply)) {
+        memmove(client->in, client->in + client->in_pos, client->in_bytes - client->in_pos);
+        client->in_bytes -= client->in_pos;
+        client->in_pos = 0;
+        ssize_t n = read(client->fd, client->in + client->in_bytes, sizeof(client->in) - client->in_bytes);
+        if (n == 0) {
+            return -1;  // Daemon bağlantıyı kapattı
+        }
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Error receiving replies");
+            return -1;
+        }
+        client->in_bytes += (size_t)n;
+    }
+
+    memcpy(reply, client->in + client->in_pos, sizeof(WireReply));
+    client->in_pos += sizeof(WireReply);
+    return 0;
+}
+
+void bank_client_close(BankClient *client) {
+    bank_client_flush(client);
+    close(client->fd);
+}
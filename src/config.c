@@ -0,0 +1,288 @@
+#include "../include/config.h"   // Config yapısı ve modlar
+#include "../include/retry.h"    // RETRY_DEFAULT_BACKOFF_MS
+#include <stdio.h>                // printf, fprintf
+#include <stdlib.h>               // atoi
+#include <string.h>               // strcmp
+#include <unistd.h>               // getopt, sysconf
+
+// Kullanım bilgisini ekrana yazar
+static void print_usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-m fork|pool|sched|ordered|serial|shard] [-e processes|threads] [-w workers]\n"
+            "       [-p] [-N interleave|partition] [-l sem|futex] [-c] [-d]\n"
+            "       [-a accounts_file] [-t transactions_file] [-j journal_file [-g records] [-G ms]] [-R]\n"
+            "       [-S snapshot_file [-k ms]] [-A ms] [-r attempts [-B ms]] [-D socket] [-b] [-q] [-K accounts]\n"
+            "  -m MODE     execution mode (default: pool)\n"
+            "                fork:  one child process per transaction, at most 1000 at a time\n"
+            "                       (legacy)\n"
+            "                pool:  fixed pool of long-lived worker processes\n"
+            "                sched: pool running waves of transactions on disjoint accounts\n"
+            "                       without locks (-l is ignored); same result as running\n"
+            "                       the file in order\n"
+            "                ordered: pool where every transaction waits only for the earlier\n"
+            "                       transactions on its own accounts, without locks (-l is\n"
+            "                       ignored); same result as running the file in order\n"
+            "                serial: no workers, the main process runs the file in order\n"
+            "                       without locks (baseline for sched and ordered)\n"
+            "                shard: every worker owns a range of accounts and updates them\n"
+            "                       without locks; transfers between workers are finished\n"
+            "                       by messages (-l is ignored, -k snapshots only at the end)\n"
+            "  -e ENGINE   how pool workers run (default: processes)\n"
+            "                processes: forked worker processes over System V shared memory\n"
+            "                threads: pthreads of one process over private memory with futex\n"
+            "                       locks; no IPC objects (not with -m fork, -l sem or -D)\n"
+            "  -w N        number of pool workers (default: number of CPU cores)\n"
+            "  -p          pin pool workers to CPU cores, spread over the NUMA nodes\n"
+            "              (ignored by fork and serial modes and the daemon)\n"
+            "  -N POLICY   NUMA placement of the account and log memory (implies -p):\n"
+            "                interleave: pages spread over all nodes\n"
+            "                partition: each shard's accounts on its worker's node, the rest\n"
+            "                       interleaved (-m shard only)\n"
+            "              skipped on single-node machines\n"
+            "  -l BACKEND  account lock backend (default: futex)\n"
+            "                sem:   System V semaphore set, one semop() per lock/unlock\n"
+            "                futex: futex word per account in shared memory\n"
+            "  -c          lock-free deposits and withdrawals (atomic add / CAS on the balance);\n"
+            "              transfers still lock both accounts\n"
+            "  -d          pre-aggregate deposits: consecutive deposits to the same account in\n"
+            "              a batch update the balance once with their sum, every deposit is\n"
+            "              still logged (ignored by fork mode and the daemon)\n"
+            "  -a FILE     accounts file (default: " ACCOUNTS_FILE ")\n"
+            "  -t FILE     transactions file (default: " TRANSACTIONS_FILE ")\n"
+            "  -j FILE     write applied transactions to a journal file (fdatasync per group)\n"
+            "  -g N        journal group commit size in records (default: %d)\n"
+            "  -G MS       journal group commit time window in milliseconds (default: %d)\n"
+            "  -R          recovery: rebuild balances from the accounts file (or the -S snapshot)\n"
+            "              and the -j journal, print them and exit without running transactions\n"
+            "  -S FILE     load accounts from this binary snapshot if it exists, and write\n"
+            "              snapshots of the balances to it while running and at the end\n"
+            "  -k MS       snapshot interval in milliseconds, 0 = only at the end (default: %d)\n"
+            "  -A MS       audit: sum a consistent snapshot of all balances every MS milliseconds\n"
+            "              while the workers run, without stopping them (ignored by fork and\n"
+            "              shard modes and the daemon)\n"
+            "  -r N        deferred retries: a failed withdrawal, transfer or multi-leg transaction\n"
+            "              waits until its debited accounts can cover it, then the workers retry\n"
+            "              it, at most N times; -m pool retries while the file runs, the other\n"
+            "              modes after it (default: 0 = retry every failed transaction once, at\n"
+            "              the end)\n"
+            "  -B MS       backoff before a deferred retry that failed again; doubles with every\n"
+            "              attempt (default: %d)\n"
+            "  -D PATH     daemon: keep the accounts in memory and run transactions sent by\n"
+            "              clients (bank-load) to the Unix socket PATH until SIGINT / SIGTERM;\n"
+            "              one process per connection, -m, -w, -t, -r and -k are ignored; with -j a\n"
+            "              reply is sent only after its journal record is fdatasync'd (durable ack)\n"
+            "  -b          benchmark: measure throughput, per-transaction latency and lock wait time\n"
+            "  -q          quiet: do not print the transaction log, retries and final balances\n"
+            "  -K N        number of hottest accounts in the contention report (default: %d,\n"
+            "              the report is only printed by a STATS=1 build)\n",
+            prog, JOURNAL_DEFAULT_GROUP, JOURNAL_DEFAULT_WINDOW_MS, SNAPSHOT_DEFAULT_INTERVAL_MS,
+            RETRY_DEFAULT_BACKOFF_MS, CONTENTION_DEFAULT_TOP_K);
+}
+
+int parse_config(int argc, char *argv[], Config *config) {
+    // Varsayılan değerler
+    config->mode = MODE_POOL;
+    config->engine = ENGINE_PROCESSES;
+    config->num_workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (config->num_workers < 1) {
+        config->num_workers = 1;  // sysconf başarısız olursa en az bir worker
+    }
+    config->pin_workers = 0;
+    config->memory_placement = MEMORY_DEFAULT;
+    config->lock_backend = LOCK_FUTEX;
+    config->lock_free_single = 0;
+    config->aggregate_deposits = 0;
+    config->accounts_file = ACCOUNTS_FILE;
+    config->transactions_file = TRANSACTIONS_FILE;
+    config->journal_file = NULL;
+    config->journal_group = JOURNAL_DEFAULT_GROUP;
+    config->journal_window_ms = JOURNAL_DEFAULT_WINDOW_MS;
+    config->recover = 0;
+    config->snapshot_file = NULL;
+    config->snapshot_interval_ms = SNAPSHOT_DEFAULT_INTERVAL_MS;
+    config->audit_interval_ms = 0;
+    config->retry_attempts = 0;
+    config->retry_backoff_ms = RETRY_DEFAULT_BACKOFF_MS;
+    config->daemon_socket = NULL;
+    config->bench = 0;
+    config->quiet = 0;
+    config->top_k = CONTENTION_DEFAULT_TOP_K;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:e:w:pN:l:cda:t:j:g:G:RS:k:A:r:B:D:bqK:h")) != -1) {
+        switch (opt) {
+            case 'm':
+                if (strcmp(optarg, "fork") == 0) {
+                    config->mode = MODE_FORK;
+                } else if (strcmp(optarg, "pool") == 0) {
+                    config->mode = MODE_POOL;
+                } else if (strcmp(optarg, "sched") == 0) {
+                    config->mode = MODE_SCHED;
+                } else if (strcmp(optarg, "ordered") == 0) {
+                    config->mode = MODE_ORDERED;
+                } else if (strcmp(optarg, "serial") == 0) {
+                    config->mode = MODE_SERIAL;
+                } else if (strcmp(optarg, "shard") == 0) {
+                    config->mode = MODE_SHARD;
+                } else {
+                    fprintf(stderr, "Unknown mode: %s\n", optarg);
+                    print_usage(argv[0]);
+                    return -1;
+                }
+                break;
+            case 'e':
+                if (strcmp(optarg, "processes") == 0) {
+                    config->engine = ENGINE_PROCESSES;
+                } else if (strcmp(optarg, "threads") == 0) {
+                    config->engine = ENGINE_THREADS;
+                } else {
+                    fprintf(stderr, "Unknown engine: %s\n", optarg);
+                    print_usage(argv[0]);
+                    return -1;
+                }
+                break;
+            case 'w':
+                config->num_workers = atoi(optarg);
+                if (config->num_workers < 1) {
+                    fprintf(stderr, "Worker count must be at least 1\n");
+                    return -1;
+                }
+                break;
+            case 'p':
+                config->pin_workers = 1;
+                break;
+            case 'N':
+                if (strcmp(optarg, "interleave") == 0) {
+                    config->memory_placement = MEMORY_INTERLEAVE;
+                } else if (strcmp(optarg, "partition") == 0) {
+                    config->memory_placement = MEMORY_PARTITION;
+                } else {
+                    fprintf(stderr, "Unknown NUMA placement: %s\n", optarg);
+                    print_usage(argv[0]);
+                    return -1;
+                }
+                config->pin_workers = 1;  // Yerel bellek ancak worker node'unda kalırsa işe yarar
+                break;
+            case 'l':
+                if (strcmp(optarg, "sem") == 0) {
+                    config->lock_backend = LOCK_SEM;
+                } else if (strcmp(optarg, "futex") == 0) {
+                    config->lock_backend = LOCK_FUTEX;
+                } else {
+                    fprintf(stderr, "Unknown lock backend: %s\n", optarg);
+                    print_usage(argv[0]);
+                    return -1;
+                }
+                break;
+            case 'c':
+                config->lock_free_single = 1;
+                break;
+            case 'd':
+                config->aggregate_deposits = 1;
+                break;
+            case 'a':
+                config->accounts_file = optarg;
+                break;
+            case 't':
+                config->transactions_file = optarg;
+                break;
+            case 'j':
+                config->journal_file = optarg;
+                break;
+            case 'g':
+                config->journal_group = atoi(optarg);
+                if (config->journal_group < 1) {
+                    fprintf(stderr, "Journal group size must be at least 1\n");
+                    return -1;
+                }
+                break;
+            case 'G':
+                config->journal_window_ms = atoi(optarg);
+                if (config->journal_window_ms < 0) {
+                    fprintf(stderr, "Journal time window cannot be negative\n");
+                    return -1;
+                }
+                break;
+            case 'R':
+                config->recover = 1;
+                break;
+            case 'S':
+                config->snapshot_file = optarg;
+                break;
+            case 'k':
+                config->snapshot_interval_ms = atoi(optarg);
+                if (config->snapshot_interval_ms < 0) {
+                    fprintf(stderr, "Snapshot interval cannot be negative\n");
+                    return -1;
+                }
+                break;
+            case 'A':
+                config->audit_interval_ms = atoi(optarg);
+                if (config->audit_interval_ms < 0) {
+                    fprintf(stderr, "Audit interval cannot be negative\n");
+                    return -1;
+                }
+                break;
+            case 'r':
+                config->retry_attempts = atoi(optarg);
+                if (config->retry_attempts < 0) {
+                    fprintf(stderr, "Retry attempts cannot be negative\n");
+                    return -1;
+                }
+                break;
+            case 'B':
+                config->retry_backoff_ms = atoi(optarg);
+                if (config->retry_backoff_ms < 0) {
+                    fprintf(stderr, "Retry backoff cannot be negative\n");
+                    return -1;
+                }
+                break;
+            case 'D':
+                config->daemon_socket = optarg;
+                break;
+            case 'b':
+                config->bench = 1;
+                break;
+            case 'q':
+                config->quiet = 1;
+                break;
+            case 'K':
+                config->top_k = atoi(optarg);
+                if (config->top_k < 0) {
+                    fprintf(stderr, "Report size cannot be negative\n");
+                    return -1;
+                }
+                break;
+            default:
+                print_usage(argv[0]);
+                return -1;
+        }
+    }
+
+    // Kurtarma modu hangi journal'ın okunacağını bilmeli
+    if (config->recover && config->journal_file == NULL) {
+        fprintf(stderr, "Recovery (-R) needs a journal file (-j FILE)\n");
+        return -1;
+    }
+
+    // Hesap aralıklarını worker'lara yalnızca shard modu bağlar; diğer modlarda
+    // worker'lar işlemleri dosya sırasıyla alır ve aralık yerelliği işe yaramaz
+    if (config->memory_placement == MEMORY_PARTITION && config->mode != MODE_SHARD) {
+        fprintf(stderr, "NUMA partition placement (-N partition) needs -m shard\n");
+        return -1;
+    }
+
+    // Thread engine'inde IPC yok: semaphore kilitleri, process başına işlem ve
+    // bağlantı başına process'ler bu engine ile çalışmaz
+    if (config->engine == ENGINE_THREADS) {
+        if (config->mode == MODE_FORK || config->daemon_socket != NULL) {
+            fprintf(stderr, "The threads engine (-e threads) does not support -m fork or -D\n");
+            return -1;
+        }
+        if (config->lock_backend == LOCK_SEM) {
+            fprintf(stderr, "The threads engine (-e threads) uses futex locks, -l sem is not supported\n");
+            return -1;
+        }
+    }
+    return 0;
+}
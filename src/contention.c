@@ -0,0 +1,75 @@
+#include "../include/contention.h"  // AccountStats
+#include "../include/utils.h"       // shared_alloc
+
+AccountStats *account_stats_create(int num_accounts) {
+    size_t size = (size_t)num_accounts * sizeof(AccountStats);
+    return (AccountStats *)shared_alloc(size, "account stats");  // Sıfırlanmış gelir
+}
+
+void account_stats_destroy(AccountStats *stats) {
+    shared_free(stats);
+}
+
+// Sıralama için sayaçlar (qsort karşılaştırıcısı global dizi görmesin diye kopyalanır)
+typedef struct {
+    int slot;
+    AccountStats stats;
+} RankedAccount;
+
+// Önce bekleme süresi, sonra bekleme sayısı, kilit sayısı ve başarısız işlem sayısı (azalan)
+static int compare_hot(const void *a, const void *b) {
+    const AccountStats *x = &((const RankedAccount *)a)->stats;
+    const AccountStats *y = &((const RankedAccount *)b)->stats;
+    if (x->wait_ns != y->wait_ns) {
+        return x->wait_ns < y->wait_ns ? 1 : -1;
+    }
+    if (x->contended != y->contended) {
+        return x->contended < y->contended ? 1 : -1;
+    }
+    if (x->acquisitions != y->acquisitions) {
+        return x->acquisitions < y->acquisitions ? 1 : -1;
+    }
+    if (x->failures != y->failures) {
+        return x->failures < y->failures ? 1 : -1;
+    }
+    return ((const RankedAccount *)a)->slot - ((const RankedAccount *)b)->slot;
+}
+
+void account_stats_report(const AccountStats *stats, const Account *accounts, int num_accounts, int top_k) {
+    // Hiç kullanılmamış hesaplar sıralanmaz
+    RankedAccount *ranked = (RankedAccount *)malloc((num_accounts > 0 ? num_accounts : 1) * sizeof(RankedAccount));
+    AccountStats total = { 0, 0, 0, 0 };
+    int active = 0;
+    for (int slot = 0; slot < num_accounts; slot++) {
+        const AccountStats *s = &stats[slot];
+        total.acquisitions += s->acquisitions;
+        total.contended += s->contended;
+        total.wait_ns += s->wait_ns;
+        total.failures += s->failures;
+        if (s->acquisitions > 0 || s->failures > 0) {
+            ranked[active].slot = slot;
+            ranked[active].stats = *s;
+            active++;
+        }
+    }
+
+    printf("\nLock contention: %ld of %ld acquisitions waited (%.2f%%), %.3f ms waiting, %ld failed debits\n",
+           total.contended, total.acquisitions,
+           total.acquisitions > 0 ? 100.0 * total.contended / total.acquisitions : 0.0,
+           total.wait_ns / 1e6, total.failures);
+
+    qsort(ranked, active, sizeof(RankedAccount), compare_hot);
+    if (top_k > active) {
+        top_k = active;
+    }
+    if (top_k > 0) {
+        printf("Hottest accounts:\n");
+        printf("%20s %14s %12s %12s %10s\n", "account", "acquisitions", "contended", "wait ms", "failures");
+        for (int i = 0; i < top_k; i++) {
+            const AccountStats *s = &ranked[i].stats;
+            printf("%20lld %14ld %12ld %12.3f %10ld\n", (long long)accounts[ranked[i].slot].account_id,
+                   s->acquisitions, s->contended, s->wait_ns / 1e6, s->failures);
+        }
+    }
+    free(ranked);
+}
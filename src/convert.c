@@ -0,0 +1,267 @@
+#include "../include/binfmt.h"        // İkili dosya formatı
+#include "../include/ingest.h"        // Metin işlem dosyası okuyucu
+#include "../include/transactions.h"  // load_accounts
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>                    // open
+#include <unistd.h>                   // close
+#include <sys/mman.h>                 // mmap
+#include <sys/stat.h>                 // fstat
+
+// 🔄 bank-convert: metin ↔ ikili dosya dönüştürücü
+// Giriş dosyası ikili ise metne, metin ise ikiliye çevrilir
+
+// Bir seferde dönüştürülen işlem sayısı
+#define CONVERT_BATCH 65536
+
+static void print_usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s transactions|accounts INPUT OUTPUT\n"
+            "  Converts a text file to the binary format, or a binary file back to text.\n"
+            "  The direction is detected from INPUT.\n",
+            prog);
+}
+
+// Çıkış dosyasının başına başlık için yer bırakır
+static FILE *open_binary_output(const char *filename) {
+    FILE *out = fopen(filename, "wb");
+    if (out == NULL) {
+        perror("Error opening output file");
+        return NULL;
+    }
+    BinaryHeader empty;
+    memset(&empty, 0, sizeof(empty));
+    fwrite(&empty, sizeof(empty), 1, out);
+    return out;
+}
+
+// Kayıtlar yazıldıktan sonra gerçek başlığı dosyanın başına yazar
+static int finish_binary_output(FILE *out, const char *magic, uint32_t record_size,
+                                uint64_t record_count, const BinaryChecksum *checksum) {
+    BinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, magic, 4);
+    header.version = BINARY_FORMAT_VERSION;
+    header.record_size = record_size;
+    header.record_count = record_count;
+    header.checksum = binary_checksum_final(checksum);
+
+    if (fseek(out, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, out) != 1) {
+        perror("Error writing binary header");
+        fclose(out);
+        return -1;
+    }
+    if (fclose(out) != 0) {
+        perror("Error closing output file");
+        return -1;
+    }
+    return 0;
+}
+
+// Dosyayı okumak için belleğe eşler (boş veya açılamayan dosyada NULL döner;
+// açılamayan dosya için hatayı metin okuyucu verir)
+static const char *map_file(const char *filename, size_t *size) {
+    *size = 0;
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror("mmap failed for input file");
+        return NULL;
+    }
+    *size = st.st_size;
+    return (const char *)data;
+}
+
+// Metin işlem dosyası → ikili (akış halinde, dosya boyutundan bağımsız bellek)
+static int transactions_to_binary(const char *input, const char *output) {
+    TransactionReader reader;
+    if (reader_open(&reader, input) == -1) {
+        return -1;
+    }
+    FILE *out = open_binary_output(output);
+    if (out == NULL) {
+        reader_close(&reader);
+        return -1;
+    }
+
+    Transaction *batch = (Transaction *)malloc(CONVERT_BATCH * sizeof(Transaction));
+    Leg *legs = (Leg *)malloc((size_t)CONVERT_BATCH * MULTI_MAX_LEGS * sizeof(Leg));
+    BinaryChecksum checksum;
+    binary_checksum_init(&checksum);
+    uint64_t total = 0;    // İşlem sayısı
+    uint64_t records = 0;  // Kayıt sayısı (çok ayaklı işlemin ayakları ayrı kayıttır)
+    int count;
+    do {
+        reader.legs = legs;
+        count = reader_next_batch(&reader, batch, CONVERT_BATCH);
+        int start = 0;  // Henüz yazılmamış düz kayıtların başı
+        for (int j = 0; j <= count; j++) {
+            if (j < count && batch[j].type != MULTI_LEG) {
+                continue;
+            }
+            binary_checksum_update(&checksum, batch + start, (j - start) * sizeof(Transaction));
+            fwrite(batch + start, sizeof(Transaction), j - start, out);
+            records += j - start;
+            start = j + 1;
+            if (j == count) {
+                break;
+            }
+
+            // Başlık kaydı ve arkasından ayak kayıtları
+            const Leg *txn_legs = legs + batch[j].from_account;
+            int num_legs = (int)batch[j].to_account;
+            Transaction group[MULTI_MAX_LEGS + 1];
+            memset(group, 0, sizeof(group));
+            group[0].from_account = -1;
+            group[0].to_account = num_legs;
+            group[0].type = MULTI_LEG;
+            group[0].amount = batch[j].amount;
+            for (int k = 0; k < num_legs; k++) {
+                group[k + 1].from_account = txn_legs[k].account_id;
+                group[k + 1].to_account = -1;
+                group[k + 1].type = LEG_RECORD;
+                group[k + 1].amount = txn_legs[k].amount;
+            }
+            binary_checksum_update(&checksum, group, (num_legs + 1) * sizeof(Transaction));
+            fwrite(group, sizeof(Transaction), num_legs + 1, out);
+            records += num_legs + 1;
+        }
+        total += count;
+    } while (count == CONVERT_BATCH);
+
+    free(legs);
+    free(batch);
+    reader_close(&reader);
+    printf("Converted %llu transactions to binary\n", (unsigned long long)total);
+    return finish_binary_output(out, BINARY_MAGIC_TRANSACTIONS, sizeof(Transaction), records, &checksum);
+}
+
+// İkili işlem dosyası → metin
+static int transactions_to_text(const char *input, const char *output, const char *data, size_t size) {
+    if (binary_validate(data, size, BINARY_MAGIC_TRANSACTIONS, sizeof(Transaction), input) == -1) {
+        return -1;
+    }
+    FILE *out = fopen(output, "w");
+    if (out == NULL) {
+        perror("Error opening output file");
+        return -1;
+    }
+
+    const BinaryHeader *header = (const BinaryHeader *)data;
+    const Transaction *txns = (const Transaction *)(data + sizeof(BinaryHeader));
+    uint64_t total = 0;
+    for (uint64_t i = 0; i < header->record_count; i++, total++) {
+        if (txns[i].type != MULTI_LEG) {
+            fprintf(out, "%d, %lld, %lld, %d\n", txns[i].type, (long long)txns[i].from_account,
+                    (long long)txns[i].to_account, txns[i].amount);
+            continue;
+        }
+        // Çok ayaklı işlem: "3, HESAP:MİKTAR, ..." (ayak kayıtları tek satırda)
+        fprintf(out, "%d", MULTI_LEG);
+        int64_t num_legs = txns[i].to_account;
+        for (int64_t k = 0; k < num_legs && i + 1 < header->record_count; k++) {
+            i++;
+            fprintf(out, ", %lld:%d", (long long)txns[i].from_account, txns[i].amount);
+        }
+        fprintf(out, "\n");
+    }
+    fclose(out);
+    printf("Converted %llu transactions to text\n", (unsigned long long)total);
+    return 0;
+}
+
+// Metin hesap dosyası → ikili
+static int accounts_to_binary(const char *input, const char *output) {
+    Account *accounts = NULL;
+    int count = load_accounts(input, &accounts);
+    if (count < 0) {
+        free(accounts);
+        return -1;
+    }
+
+    FILE *out = open_binary_output(output);
+    if (out == NULL) {
+        free(accounts);
+        return -1;
+    }
+    BinaryChecksum checksum;
+    binary_checksum_init(&checksum);
+    binary_checksum_update(&checksum, accounts, count * sizeof(Account));
+    fwrite(accounts, sizeof(Account), count, out);
+    free(accounts);
+
+    printf("Converted %d accounts to binary\n", count);
+    return finish_binary_output(out, BINARY_MAGIC_ACCOUNTS, sizeof(Account), count, &checksum);
+}
+
+// İkili hesap dosyası → metin (ilk satır hesap sayısı)
+static int accounts_to_text(const char *input, const char *output, const char *data, size_t size) {
+    if (binary_validate(data, size, BINARY_MAGIC_ACCOUNTS, sizeof(Account), input) == -1) {
+        return -1;
+    }
+    FILE *out = fopen(output, "w");
+    if (out == NULL) {
+        perror("Error opening output file");
+        return -1;
+    }
+
+    const BinaryHeader *header = (const BinaryHeader *)data;
+    const Account *accounts = (const Account *)(data + sizeof(BinaryHeader));
+    fprintf(out, "%llu\n", (unsigned long long)header->record_count);
+    for (uint64_t i = 0; i < header->record_count; i++) {
+        fprintf(out, "%lld, %d\n", (long long)accounts[i].account_id, accounts[i].balance);
+    }
+    fclose(out);
+    printf("Converted %llu accounts to text\n", (unsigned long long)header->record_count);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 4) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *kind = argv[1];
+    const char *input = argv[2];
+    const char *output = argv[3];
+    int is_accounts;
+    if (strcmp(kind, "accounts") == 0) {
+        is_accounts = 1;
+    } else if (strcmp(kind, "transactions") == 0) {
+        is_accounts = 0;
+    } else {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Yön giriş dosyasının başlığından anlaşılır
+    size_t size = 0;
+    const char *data = map_file(input, &size);
+    const char *magic = is_accounts ? BINARY_MAGIC_ACCOUNTS : BINARY_MAGIC_TRANSACTIONS;
+    int binary_input = data != NULL && is_binary_file(data, size, magic);
+
+    int result;
+    if (binary_input) {
+        result = is_accounts ? accounts_to_text(input, output, data, size)
+                             : transactions_to_text(input, output, data, size);
+    } else {
+        result = is_accounts ? accounts_to_binary(input, output)
+                             : transactions_to_binary(input, output);
+    }
+
+    if (data != NULL) {
+        munmap((void *)data, size);
+    }
+    return result == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
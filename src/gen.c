@@ -0,0 +1,313 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>                     // pow
+#include <unistd.h>                   // getopt
+
+// 🎲 bank-gen: benchmark için sentetik hesap ve işlem dosyası üretici
+// Aynı ayarlar ve tohum (seed) her zaman aynı dosyaları üretir
+
+#define GEN_DEFAULT_TRANSACTIONS 1000000
+#define GEN_DEFAULT_ACCOUNTS 10000
+#define GEN_DEFAULT_BALANCE 1000
+#define GEN_DEFAULT_MAX_AMOUNT 100
+
+// Çok ayaklı işlemin ayak sınırı (accounts.h'deki MULTI_MAX_LEGS ile aynı)
+#define GEN_MAX_LEGS 16
+
+static void print_usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-n transactions] [-a accounts] [-B balance] [-M max_amount]\n"
+            "       [-x deposit,withdraw,transfer] [-z skew] [-s seed] [-i] [-A] [-L legs [-E]]\n"
+            "       ACCOUNTS_OUT TRANSACTIONS_OUT\n"
+            "  -n N      number of transactions (default: %d)\n"
+            "  -a N      number of accounts (default: %d)\n"
+            "  -B N      initial balance of every account (default: %d)\n"
+            "  -M N      amounts are drawn uniformly from 1..N (default: %d)\n"
+            "  -x D,W,T  relative weights of deposits, withdrawals and transfers (default: 30,20,50)\n"
+            "  -z S      Zipf exponent for choosing accounts, 0 = uniform (default: 0)\n"
+            "            with S around 1 a few hot accounts receive most of the transactions\n"
+            "  -s SEED   random seed (default: 1)\n"
+            "  -i        random sparse 64-bit account IDs instead of 0..N-1\n"
+            "  -A        adjacent sweep: transaction i uses account i mod N and transfers go\n"
+            "            to the next account, so concurrent transactions touch neighbouring\n"
+            "            accounts (false sharing benchmark, -z is ignored)\n"
+            "  -L N      transfers become multi-leg settlements: one account pays N-1 other\n"
+            "            accounts in a single all-or-nothing transaction (2..%d legs)\n"
+            "  -E        with -L, write every settlement as N-1 plain transfers instead\n"
+            "            (the emulation the multi-leg type replaces, for benchmarks)\n",
+            prog, GEN_DEFAULT_TRANSACTIONS, GEN_DEFAULT_ACCOUNTS, GEN_DEFAULT_BALANCE,
+            GEN_DEFAULT_MAX_AMOUNT, GEN_MAX_LEGS);
+}
+
+// splitmix64: küçük, hızlı ve her platformda aynı sırayı veren rastgele sayı üretici
+static uint64_t rng_state;
+
+static uint64_t rng_next(void) {
+    uint64_t z = (rng_state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// [0, 1) aralığında düzgün dağılımlı sayı
+static double rng_uniform(void) {
+    return (rng_next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// [0, n) aralığında tamsayı
+static long rng_below(long n) {
+    return (long)(rng_uniform() * n);
+}
+
+/*
+ * Hesap seçici: Zipf dağılımında k. sıradaki hesabın seçilme olasılığı 1 / (k+1)^s
+ * cdf: Kümülatif olasılıklar (s = 0 ise NULL, düzgün dağılım)
+ * order: Sıra → hesap dizisindeki yer; sıcak hesaplar dizide yan yana durmasın diye karıştırılır
+ */
+typedef struct {
+    int num_accounts;
+    double *cdf;
+    int *order;
+} AccountPicker;
+
+static void picker_init(AccountPicker *picker, int num_accounts, double skew) {
+    picker->num_accounts = num_accounts;
+    picker->cdf = NULL;
+    if (skew > 0) {
+        picker->cdf = (double *)malloc(num_accounts * sizeof(double));
+        double sum = 0;
+        for (int k = 0; k < num_accounts; k++) {
+            sum += 1.0 / pow(k + 1, skew);
+            picker->cdf[k] = sum;
+        }
+        for (int k = 0; k < num_accounts; k++) {
+            picker->cdf[k] /= sum;
+        }
+    }
+
+    // Fisher-Yates karıştırma
+    picker->order = (int *)malloc(num_accounts * sizeof(int));
+    for (int k = 0; k < num_accounts; k++) {
+        picker->order[k] = k;
+    }
+    for (int k = num_accounts - 1; k > 0; k--) {
+        int j = (int)rng_below(k + 1);
+        int tmp = picker->order[k];
+        picker->order[k] = picker->order[j];
+        picker->order[j] = tmp;
+    }
+}
+
+// Bir hesabın dizideki yerini seçer
+static int picker_next(const AccountPicker *picker) {
+    if (picker->cdf == NULL) {
+        return (int)rng_below(picker->num_accounts);
+    }
+    // cdf[k] >= u olan ilk k (ikili arama)
+    double u = rng_uniform();
+    int low = 0;
+    int high = picker->num_accounts - 1;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (picker->cdf[mid] < u) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return picker->order[low];
+}
+
+// "30,20,50" biçimindeki ağırlıkları okur
+static int parse_mix(const char *text, int weights[3]) {
+    if (sscanf(text, "%d,%d,%d", &weights[0], &weights[1], &weights[2]) != 3 ||
+        weights[0] < 0 || weights[1] < 0 || weights[2] < 0 ||
+        weights[0] + weights[1] + weights[2] == 0) {
+        fprintf(stderr, "Invalid mix: %s (expected three non-negative weights, e.g. 30,20,50)\n", text);
+        return -1;
+    }
+    return 0;
+}
+
+static FILE *open_output(const char *filename) {
+    FILE *out = fopen(filename, "w");
+    if (out == NULL) {
+        perror("Error opening output file");
+        return NULL;
+    }
+    setvbuf(out, NULL, _IOFBF, 1 << 20);
+    return out;
+}
+
+int main(int argc, char *argv[]) {
+    long num_transactions = GEN_DEFAULT_TRANSACTIONS;
+    int num_accounts = GEN_DEFAULT_ACCOUNTS;
+    int balance = GEN_DEFAULT_BALANCE;
+    int max_amount = GEN_DEFAULT_MAX_AMOUNT;
+    int weights[3] = { 30, 20, 50 };
+    double skew = 0;
+    uint64_t seed = 1;
+    int sparse_ids = 0;
+    int adjacent = 0;
+    int legs = 0;      // -L: 0 ise düz transfer
+    int emulate = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:a:B:M:x:z:s:iAL:Eh")) != -1) {
+        switch (opt) {
+            case 'n':
+                num_transactions = atol(optarg);
+                break;
+            case 'a':
+                num_accounts = atoi(optarg);
+                break;
+            case 'B':
+                balance = atoi(optarg);
+                break;
+            case 'M':
+                max_amount = atoi(optarg);
+                break;
+            case 'x':
+                if (parse_mix(optarg, weights) == -1) {
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'z':
+                skew = atof(optarg);
+                break;
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'i':
+                sparse_ids = 1;
+                break;
+            case 'A':
+                adjacent = 1;
+                break;
+            case 'L':
+                legs = atoi(optarg);
+                break;
+            case 'E':
+                emulate = 1;
+                break;
+            default:
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (argc - optind != 2 || num_transactions < 0 || num_accounts < 1 || balance < 0 ||
+        max_amount < 1 || skew < 0 || (legs != 0 && (legs < 2 || legs > GEN_MAX_LEGS))) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    // Transfer için iki, çok ayaklı işlem için ayak sayısı kadar farklı hesap gerekir
+    if (num_accounts < (legs > 2 ? legs : 2)) {
+        weights[2] = 0;
+        if (weights[0] + weights[1] == 0) {
+            fprintf(stderr, "Transfers need at least two accounts\n");
+            return EXIT_FAILURE;
+        }
+    }
+    rng_state = seed;
+
+    // Hesap ID'leri: 0..N-1 veya (-i) rastgele, tekrarsız 63-bit değerler
+    int64_t *ids = (int64_t *)malloc(num_accounts * sizeof(int64_t));
+    for (int k = 0; k < num_accounts; k++) {
+        if (sparse_ids) {
+            // Üst bitler rastgele, alt 32 bit sıra numarası: ID'ler hiçbir zaman tekrar etmez
+            ids[k] = (int64_t)((rng_next() >> 1) & ~0xffffffffULL) | k;
+        } else {
+            ids[k] = k;
+        }
+    }
+
+    FILE *accounts_out = open_output(argv[optind]);
+    if (accounts_out == NULL) {
+        return EXIT_FAILURE;
+    }
+    fprintf(accounts_out, "%d\n", num_accounts);
+    for (int k = 0; k < num_accounts; k++) {
+        fprintf(accounts_out, "%lld, %d\n", (long long)ids[k], balance);
+    }
+    if (fclose(accounts_out) != 0) {
+        perror("Error writing accounts file");
+        return EXIT_FAILURE;
+    }
+
+    FILE *txns_out = open_output(argv[optind + 1]);
+    if (txns_out == NULL) {
+        return EXIT_FAILURE;
+    }
+    AccountPicker picker;
+    picker_init(&picker, num_accounts, skew);
+    int total_weight = weights[0] + weights[1] + weights[2];
+
+    for (long i = 0; i < num_transactions; i++) {
+        long w = rng_below(total_weight);
+        int amount = 1 + (int)rng_below(max_amount);
+        // -A: hesaplar dizideki sırayla, ardışık işlemler komşu hesaplara düşer
+        int k = adjacent ? (int)(i % num_accounts) : picker_next(&picker);
+        if (w < weights[0]) {
+            fprintf(txns_out, "0, -1, %lld, %d\n", (long long)ids[k], amount);
+        } else if (w < weights[0] + weights[1]) {
+            fprintf(txns_out, "1, %lld, -1, %d\n", (long long)ids[k], amount);
+        } else if (legs > 0) {
+            // Ödeyen k, alacaklılar tekrarsız seçilir; borç alacakların toplamıdır
+            int parties[GEN_MAX_LEGS];
+            int credits[GEN_MAX_LEGS];
+            int debit = 0;
+            parties[0] = k;
+            for (int p = 1; p < legs; p++) {
+                int fresh;
+                do {
+                    parties[p] = adjacent ? (parties[p - 1] + 1) % num_accounts : picker_next(&picker);
+                    fresh = 1;
+                    for (int q = 0; q < p; q++) {
+                        fresh &= parties[q] != parties[p];
+                    }
+                } while (!fresh);
+                credits[p] = p == 1 ? amount : 1 + (int)rng_below(max_amount);
+                debit += credits[p];
+            }
+            if (emulate) {
+                for (int p = 1; p < legs; p++) {
+                    fprintf(txns_out, "2, %lld, %lld, %d\n", (long long)ids[k], (long long)ids[parties[p]],
+                            credits[p]);
+                }
+            } else {
+                fprintf(txns_out, "3, %lld:-%d", (long long)ids[k], debit);
+                for (int p = 1; p < legs; p++) {
+                    fprintf(txns_out, ", %lld:%d", (long long)ids[parties[p]], credits[p]);
+                }
+                fprintf(txns_out, "\n");
+            }
+        } else {
+            int from = k;
+            int to;
+            if (adjacent) {
+                to = (from + 1) % num_accounts;
+            } else {
+                do {
+                    to = picker_next(&picker);
+                } while (to == from);
+            }
+            fprintf(txns_out, "2, %lld, %lld, %d\n", (long long)ids[from], (long long)ids[to], amount);
+        }
+    }
+    if (fclose(txns_out) != 0) {
+        perror("Error writing transactions file");
+        return EXIT_FAILURE;
+    }
+
+    printf("Generated %d accounts and %ld transactions (mix %d,%d,%d, skew %.2f)\n",
+           num_accounts, num_transactions, weights[0], weights[1], weights[2], skew);
+    if (legs > 0) {
+        printf("Transfers are %d-leg settlements%s\n", legs, emulate ? ", written as chains of transfers" : "");
+    }
+    free(picker.cdf);
+    free(picker.order);
+    free(ids);
+    return EXIT_SUCCESS;
+}
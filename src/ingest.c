@@ -0,0 +1,329 @@
+#include "../include/ingest.h"   // TransactionReader
+#include "../include/binfmt.h"   // İkili dosya formatı
+#include <stdio.h>                // fprintf, perror
+#include <string.h>               // memcpy
+#include <stdint.h>               // int64_t, INT32_MAX, INT64_MAX
+#include <fcntl.h>                // open
+#include <unistd.h>               // close, sysconf
+#include <sys/mman.h>             // mmap, munmap, madvise
+#include <sys/stat.h>             // fstat
+
+// Okunan kısım bu kadar büyüyünce arkada kalan sayfalar bırakılır
+#define READER_RELEASE_BYTES (16 * 1024 * 1024)
+
+int reader_open(TransactionReader *reader, const char *filename) {
+    reader->data = NULL;
+    reader->size = 0;
+    reader->pos = 0;
+    reader->released = 0;
+    reader->line = 0;
+    reader->binary = 0;
+    reader->legs = NULL;
+    reader->num_legs = 0;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        perror("Error opening transactions file");
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        perror("fstat failed for transactions file");
+        close(fd);
+        return -1;
+    }
+
+    if (st.st_size > 0) {
+        void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            perror("mmap failed for transactions file");
+            close(fd);
+            return -1;
+        }
+        // Dosya baştan sona bir kez okunacak: kernel önden okuma yapsın
+        madvise(data, st.st_size, MADV_SEQUENTIAL);
+        reader->data = data;
+        reader->size = st.st_size;
+
+        // İkili dosya: başlığı ve sağlama toplamını doğrula, kayıtlar başlığın arkasında
+        if (is_binary_file(data, st.st_size, BINARY_MAGIC_TRANSACTIONS)) {
+            if (binary_validate(data, st.st_size, BINARY_MAGIC_TRANSACTIONS, sizeof(Transaction), filename) == -1) {
+                munmap(data, st.st_size);
+                reader->data = NULL;
+                close(fd);
+                return -1;
+            }
+            // Doğrulama tüm sayfaları okudu; asıl okuma sırasında tekrar getirilecekler
+            madvise(data, st.st_size, MADV_DONTNEED);
+            reader->binary = 1;
+            reader->pos = sizeof(BinaryHeader);
+        }
+    }
+
+    close(fd);  // Eşleme dosya kapansa da geçerli kalır
+    return 0;
+}
+
+// Boşluk ve tab karakterlerini atlar
+static void skip_blanks(const char **p, const char *end) {
+    while (*p < end && (**p == ' ' || **p == '\t')) {
+        (*p)++;
+    }
+}
+
+// İşaretli bir tam sayı okur (sscanf yerine, en az bir rakam olmalı)
+// limit: Mutlak değerin üst sınırı (int veya int64_t alanı için)
+static int parse_number(const char **p, const char *end, uint64_t limit, int64_t *out) {
+    skip_blanks(p, end);
+
+    int negative = 0;
+    if (*p < end && (**p == '-' || **p == '+')) {
+        negative = (**p == '-');
+        (*p)++;
+    }
+
+    const char *start = *p;
+    uint64_t value = 0;
+    while (*p < end && **p >= '0' && **p <= '9') {
+        uint64_t digit = **p - '0';
+        if (value > (limit - digit) / 10) {
+            return -1;  // Alana sığmıyor
+        }
+        value = value * 10 + digit;
+        (*p)++;
+    }
+    if (*p == start) {
+        return -1;  // Hiç rakam yok
+    }
+
+    *out = negative ? -(int64_t)value : (int64_t)value;
+    return 0;
+}
+
+// int alanı (işlem türü, miktar)
+static int parse_int(const char **p, const char *end, int *out) {
+    int64_t value;
+    if (parse_number(p, end, INT32_MAX, &value) == -1) {
+        return -1;
+    }
+    *out = (int)value;
+    return 0;
+}
+
+// 64 bit hesap ID'si
+static int parse_id(const char **p, const char *end, int64_t *out) {
+    return parse_number(p, end, INT64_MAX, out);
+}
+
+// Virgül bekler (etrafındaki boşluklar serbest)
+static int expect_comma(const char **p, const char *end) {
+    skip_blanks(p, end);
+    if (*p < end && **p == ',') {
+        (*p)++;
+        return 0;
+    }
+    return -1;
+}
+
+// Çok ayaklı işlemin ayaklarını doğrular: 2..MULTI_MAX_LEGS ayak, sıfır olmayan miktarlar,
+// en az bir borç, farklı hesaplar, toplam sıfır ve toplam borç int'e sığmalı
+// total: Toplam borç (log kaydındaki miktar)
+static int check_legs(const Leg *legs, int num_legs, int *total) {
+    if (num_legs < 2 || num_legs > MULTI_MAX_LEGS) {
+        return -1;
+    }
+    int64_t sum = 0;
+    int64_t debit = 0;
+    for (int k = 0; k < num_legs; k++) {
+        if (legs[k].amount == 0) {
+            return -1;
+        }
+        for (int h = 0; h < k; h++) {
+            if (legs[h].account_id == legs[k].account_id) {
+                return -1;  // Aynı hesap iki kez
+            }
+        }
+        sum += legs[k].amount;
+        if (legs[k].amount < 0) {
+            debit -= legs[k].amount;
+        }
+    }
+    if (sum != 0 || debit > INT32_MAX) {
+        return -1;
+    }
+    *total = (int)debit;
+    return 0;
+}
+
+// Çok ayaklı işlemin satırının geri kalanı: ", HESAP:MİKTAR" tekrarları
+// Ayaklar legs'e yazılır; txn->to_account ayak sayısı, txn->amount toplam borç olur
+static int parse_legs(const char *p, const char *end, Transaction *txn, Leg *legs) {
+    int num_legs = 0;
+    for (;;) {
+        skip_blanks(&p, end);
+        if (p == end) {
+            break;
+        }
+        if (num_legs == MULTI_MAX_LEGS || expect_comma(&p, end) == -1 ||
+            parse_id(&p, end, &legs[num_legs].account_id) == -1) {
+            return -1;
+        }
+        skip_blanks(&p, end);
+        if (p == end || *p != ':') {
+            return -1;
+        }
+        p++;
+        if (parse_int(&p, end, &legs[num_legs].amount) == -1) {
+            return -1;
+        }
+        legs[num_legs].reserved = 0;
+        num_legs++;
+    }
+    txn->to_account = num_legs;
+    return check_legs(legs, num_legs, &txn->amount);
+}
+
+// <T_type, From_account, To_account, Amount> satırını parse eder
+// Çok ayaklı işlemde (T_type 3) ayaklar reader->legs'in sonuna eklenir
+static int parse_line(TransactionReader *reader, const char *p, const char *end, Transaction *txn) {
+    if (parse_int(&p, end, &txn->type) == -1) {
+        return -1;
+    }
+    if (txn->type == MULTI_LEG) {
+        if (reader->legs == NULL || parse_legs(p, end, txn, reader->legs + reader->num_legs) == -1) {
+            return -1;
+        }
+        txn->from_account = reader->num_legs;
+        reader->num_legs += (int)txn->to_account;
+        return 0;
+    }
+    if (expect_comma(&p, end) == -1 ||
+        parse_id(&p, end, &txn->from_account) == -1 || expect_comma(&p, end) == -1 ||
+        parse_id(&p, end, &txn->to_account) == -1 || expect_comma(&p, end) == -1 ||
+        parse_int(&p, end, &txn->amount) == -1) {
+        return -1;
+    }
+    skip_blanks(&p, end);
+    return p == end ? 0 : -1;  // Satır sonunda fazlalık olmamalı
+}
+
+// İkili dosyada çok ayaklı işlemin başlık kaydı ve arkasındaki LEG_RECORD kayıtları
+// Dönüş: Okunduysa 0 (reader->pos ayakların arkasında), bozuksa -1 (kayıt atlanır)
+static int next_binary_multi_leg(TransactionReader *reader, const Transaction *header, Transaction *out) {
+    size_t remaining = (reader->size - reader->pos) / sizeof(Transaction) - 1;
+    int num_legs = header->to_account >= 0 && header->to_account <= MULTI_MAX_LEGS ? (int)header->to_account : -1;
+    if (reader->legs == NULL || num_legs < 0 || (size_t)num_legs > remaining) {
+        return -1;
+    }
+    const Transaction *records = header + 1;
+    Leg *legs = reader->legs + reader->num_legs;
+    for (int k = 0; k < num_legs; k++) {
+        if (records[k].type != LEG_RECORD) {
+            return -1;
+        }
+        legs[k].account_id = records[k].from_account;
+        legs[k].amount = records[k].amount;
+        legs[k].reserved = 0;
+    }
+    out->type = MULTI_LEG;
+    out->to_account = num_legs;
+    if (check_legs(legs, num_legs, &out->amount) == -1) {
+        return -1;
+    }
+    out->from_account = reader->num_legs;
+    reader->num_legs += num_legs;
+    reader->pos += (num_legs + 1) * sizeof(Transaction);
+    return 0;
+}
+
+// İkili dosya: kayıtlar Transaction ile aynı, sadece kopyalanır
+// Çok ayaklı işlemler (başlık + ayak kayıtları) ayak dizisine açılır
+static int next_binary_batch(TransactionReader *reader, Transaction *out, int max_count) {
+    int count = 0;
+    while (count < max_count && reader->size - reader->pos >= sizeof(Transaction)) {
+        // Düz kayıtların arka arkaya geldiği kısım tek memcpy ile
+        const Transaction *records = (const Transaction *)(reader->data + reader->pos);
+        size_t remaining = (reader->size - reader->pos) / sizeof(Transaction);
+        int run = 0;
+        while (count + run < max_count && (size_t)run < remaining &&
+               records[run].type != MULTI_LEG && records[run].type != LEG_RECORD) {
+            run++;
+        }
+        memcpy(out + count, records, run * sizeof(Transaction));
+        count += run;
+        reader->pos += run * sizeof(Transaction);
+        if (count == max_count || (size_t)run == remaining) {
+            break;
+        }
+
+        const Transaction *header = &records[run];
+        if (header->type == MULTI_LEG && next_binary_multi_leg(reader, header, &out[count]) == 0) {
+            count++;
+            continue;
+        }
+        fprintf(stderr, "Warning: skipping malformed transaction record %ld\n",
+                (long)((reader->pos - sizeof(BinaryHeader)) / sizeof(Transaction)));
+        reader->pos += sizeof(Transaction);
+    }
+    return count;
+}
+
+// Metin dosyası: satır satır parse edilir
+static int next_text_batch(TransactionReader *reader, Transaction *out, int max_count) {
+    int count = 0;
+    const char *data = reader->data;
+
+    while (count < max_count && reader->pos < reader->size) {
+        // Satırın sonunu bul
+        const char *line_start = data + reader->pos;
+        const char *file_end = data + reader->size;
+        const char *line_end = line_start;
+        while (line_end < file_end && *line_end != '\n') {
+            line_end++;
+        }
+        reader->pos = (line_end - data) + (line_end < file_end ? 1 : 0);
+        reader->line++;
+
+        // Windows satır sonu (\r\n) ve satır sonundaki boşluklar
+        const char *content_end = line_end;
+        while (content_end > line_start &&
+               (content_end[-1] == '\r' || content_end[-1] == ' ' || content_end[-1] == '\t')) {
+            content_end--;
+        }
+        if (content_end == line_start) {
+            continue;  // Boş satır
+        }
+
+        if (parse_line(reader, line_start, content_end, &out[count]) == -1) {
+            fprintf(stderr, "Warning: skipping malformed transaction on line %ld\n", reader->line);
+            continue;
+        }
+        count++;
+    }
+    return count;
+}
+
+int reader_next_batch(TransactionReader *reader, Transaction *out, int max_count) {
+    reader->num_legs = 0;
+    int count = reader->binary ? next_binary_batch(reader, out, max_count)
+                               : next_text_batch(reader, out, max_count);
+    const char *data = reader->data;
+
+    // Okunmuş sayfaları bırak: dosya ne kadar büyük olursa olsun bellek sabit kalır
+    if (reader->pos - reader->released >= READER_RELEASE_BYTES) {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t release_end = reader->pos & ~(page - 1);
+        madvise((char *)data + reader->released, release_end - reader->released, MADV_DONTNEED);
+        reader->released = release_end;
+    }
+
+    return count;
+}
+
+void reader_close(TransactionReader *reader) {
+    if (reader->data != NULL) {
+        munmap((void *)reader->data, reader->size);
+        reader->data = NULL;
+    }
+}
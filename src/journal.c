@@ -0,0 +1,352 @@
+#include "../include/journal.h"       // Journal, JournalState
+#include "../include/transactions.h"  // DEPOSIT, WITHDRAW, TRANSFER, MULTI_LEG
+#include "../include/binfmt.h"        // BinaryHeader
+#include "../include/utils.h"         // fork, shmget, shmat
+#include <fcntl.h>                    // open
+#include <time.h>                     // clock_gettime, nanosleep
+
+// Halkada kayıt yokken yazıcının uyuduğu süre (mikrosaniye)
+#define JOURNAL_IDLE_SLEEP_US 500
+
+// Kurtarmada bir seferde okunan kayıt sayısı
+#define JOURNAL_REPLAY_BATCH 4096
+
+// İki zaman arasındaki farkı milisaniye olarak verir
+static long elapsed_ms(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000L + (now.tv_nsec - start->tv_nsec) / 1000000L;
+}
+
+// Tüm tamponu yazar (write kısmi yazabilir)
+static int write_all(int fd, const void *data, size_t size) {
+    const char *p = (const char *)data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        p += n;
+        size -= n;
+    }
+    return 0;
+}
+
+// Bir grubu tek write + tek fdatasync ile diske indirir (group commit)
+static void flush_group(int fd, const TransactionLog *group, int count, JournalState *state) {
+    if (state->failed) {
+        return;  // Önceki hatadan sonra dosya tutarsız; kayıtlar sadece tüketilir
+    }
+    if (write_all(fd, group, count * sizeof(TransactionLog)) == -1) {
+        perror("write failed for journal");
+        __atomic_store_n(&state->failed, 1, __ATOMIC_RELEASE);
+    } else if (fdatasync(fd) == -1) {
+        perror("fdatasync failed for journal");
+        __atomic_store_n(&state->failed, 1, __ATOMIC_RELEASE);
+    } else {
+        __atomic_store_n(&state->records, state->records + count, __ATOMIC_RELEASE);
+        state->syncs++;
+    }
+    // Bekleyenleri uyandır: kayıtları diskte veya yazıcı başarısız
+    __atomic_fetch_add(&state->synced_seq, 1, __ATOMIC_RELEASE);
+    futex_wake(&state->synced_seq, 0x7fffffff);
+}
+
+// Yazıcı process'in döngüsü: halkayı boşaltır, grup dolunca veya süre dolunca yazar
+static void writer_loop(Journal *journal, int fd, int group_size, int window_ms) {
+    TransactionLog *group = (TransactionLog *)malloc(group_size * sizeof(TransactionLog));
+    int pending = 0;
+    struct timespec first;  // Gruptaki ilk kaydın geliş zamanı
+
+    for (;;) {
+        // Önce stop'u oku: stop görüldükten sonraki boşaltma tüm kayıtları yakalar
+        int stopping = __atomic_load_n(&journal->state->stop, __ATOMIC_ACQUIRE);
+
+        int empty = 0;
+        while (pending < group_size) {
+            if (!log_ring_pop(journal->ring, &group[pending])) {
+                empty = 1;
+                break;
+            }
+            if (pending == 0) {
+                clock_gettime(CLOCK_MONOTONIC, &first);
+            }
+            pending++;
+        }
+
+        if (pending > 0 && (pending == group_size || stopping || elapsed_ms(&first) >= window_ms)) {
+            flush_group(fd, group, pending, journal->state);
+            pending = 0;
+        }
+        if (stopping && empty && pending == 0) {
+            break;
+        }
+        if (empty) {
+            struct timespec idle = { 0, JOURNAL_IDLE_SLEEP_US * 1000L };
+            nanosleep(&idle, NULL);
+        }
+    }
+
+    free(group);
+}
+
+int journal_open(Journal *journal, const char *filename, int group_size, int window_ms) {
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        perror("Error opening journal file");
+        return -1;
+    }
+
+    // Başlık: kayıtlar sona eklendiği için record_count ve checksum kullanılmaz (0)
+    BinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, JOURNAL_MAGIC, 4);
+    header.version = BINARY_FORMAT_VERSION;
+    header.record_size = sizeof(TransactionLog);
+    if (write_all(fd, &header, sizeof(header)) == -1 || fdatasync(fd) == -1) {
+        perror("Error writing journal header");
+        close(fd);
+        return -1;
+    }
+
+    // Paylaşılan durum: segment hemen silinmek üzere işaretlenir (bkz. shm_alloc)
+    int shm_id = shmget(IPC_PRIVATE, sizeof(JournalState), IPC_CREAT | 0666);
+    if (shm_id == -1) {
+        perror("shmget failed for journal");
+        close(fd);
+        return -1;
+    }
+    journal->state = (JournalState *)shmat(shm_id, NULL, 0);
+    shmctl(shm_id, IPC_RMID, NULL);
+    if (journal->state == (void *)-1) {
+        perror("shmat failed for journal");
+        close(fd);
+        return -1;
+    }
+    memset(journal->state, 0, sizeof(JournalState));
+
+    journal->ring = log_ring_create_shared(JOURNAL_RING_CAPACITY);
+    if (journal->ring == NULL) {
+        shmdt(journal->state);
+        close(fd);
+        return -1;
+    }
+    journal->records = 0;
+    journal->syncs = 0;
+
+    // Fork öncesi tamponu boşalt, yoksa child aynı çıktıyı tekrar yazar
+    fflush(stdout);
+    journal->writer_pid = fork();
+    if (journal->writer_pid == -1) {
+        perror("fork failed for journal writer");
+        log_ring_destroy(journal->ring);
+        shmdt(journal->state);
+        close(fd);
+        return -1;
+    } else if (journal->writer_pid == 0) {  // Yazıcı process
+        writer_loop(journal, fd, group_size, window_ms);
+        close(fd);
+        _exit(journal->state->failed ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+
+    close(fd);  // Dosyaya sadece yazıcı yazar
+    return 0;
+}
+
+long journal_append(Journal *journal, int transaction_id, int type, int64_t from_account,
+                    int64_t to_account, int amount) {
+    return 1 + log_append(journal->ring, transaction_id, type, from_account, to_account, amount, LOG_SUCCESS);
+}
+
+long journal_append_multi(Journal *journal, int transaction_id, const Leg *legs, int num_legs,
+                          int64_t first_debit, int total) {
+    TransactionLog group[MULTI_MAX_LEGS + 1];
+    group[0].transaction_id = transaction_id;
+    group[0].from_account = first_debit;
+    group[0].to_account = num_legs;
+    group[0].amount = total;
+    group[0].type = MULTI_LEG;
+    group[0].status = LOG_SUCCESS;
+    for (int k = 0; k < num_legs; k++) {
+        group[k + 1].transaction_id = transaction_id;
+        group[k + 1].from_account = legs[k].account_id;
+        group[k + 1].to_account = -1;
+        group[k + 1].amount = legs[k].amount;
+        group[k + 1].type = LEG_RECORD;
+        group[k + 1].status = LOG_SUCCESS;
+    }
+    return log_append_group(journal->ring, group, num_legs + 1) + num_legs + 1;
+}
+
+int journal_wait_synced(Journal *journal, long position) {
+    JournalState *state = journal->state;
+    for (;;) {
+        // Sırayı koşullardan önce oku: arada gelen fdatasync'in uyandırması kaçmaz
+        int seq = __atomic_load_n(&state->synced_seq, __ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&state->records, __ATOMIC_ACQUIRE) >= position) {
+            return 0;
+        }
+        if (__atomic_load_n(&state->failed, __ATOMIC_ACQUIRE)) {
+            return -1;
+        }
+        futex_wait(&state->synced_seq, seq);
+    }
+}
+
+int journal_failed(const Journal *journal) {
+    return __atomic_load_n(&journal->state->failed, __ATOMIC_ACQUIRE);
+}
+
+int journal_close(Journal *journal) {
+    // Yazıcıya dur de: halkada kalanları yazıp son fdatasync'i yapacak
+    __atomic_store_n(&journal->state->stop, 1, __ATOMIC_RELEASE);
+
+    int status;
+    if (waitpid(journal->writer_pid, &status, 0) == -1) {
+        perror("waitpid failed for journal writer");
+        return -1;
+    }
+
+    int failed = journal->state->failed;
+    journal->records = journal->state->records;
+    journal->syncs = journal->state->syncs;
+    log_ring_destroy(journal->ring);
+    shmdt(journal->state);
+    return failed ? -1 : 0;
+}
+
+// Tek bir journal kaydını bakiyelere uygular (kayıtlar sadece başarılı işlemlerdir,
+// bakiye kontrolü çalıştırma sırasında yapıldı; toplama sırası sonucu değiştirmez)
+// Dönüş: Uygulandıysa 0, hesap veya işlem türü geçersizse -1
+static int replay_record(const TransactionLog *record, AccountTable *table) {
+    int needs_from = record->type == WITHDRAW || record->type == TRANSFER;
+    int needs_to = record->type == DEPOSIT || record->type == TRANSFER;
+    if (!needs_from && !needs_to) {
+        return -1;  // Bilinmeyen işlem türü
+    }
+
+    int from = needs_from ? account_table_find(table, record->from_account) : -1;
+    int to = needs_to ? account_table_find(table, record->to_account) : -1;
+    if ((needs_from && from == -1) || (needs_to && to == -1)) {
+        return -1;  // Hesap tabloda yok
+    }
+
+    if (needs_from) {
+        *account_balance(table, from) -= record->amount;
+    }
+    if (needs_to) {
+        *account_balance(table, to) += record->amount;
+    }
+    return 0;
+}
+
+// Çok ayaklı işlemin ayak kayıtlarını uygular; hesaplardan biri yoksa hiçbirini uygulamaz
+// Dönüş: Uygulandıysa 0, aksi halde -1
+static int replay_legs(const TransactionLog *legs, int num_legs, AccountTable *table) {
+    int slots[MULTI_MAX_LEGS];
+    for (int k = 0; k < num_legs; k++) {
+        slots[k] = account_table_find(table, legs[k].from_account);
+        if (slots[k] == -1) {
+            return -1;
+        }
+    }
+    for (int k = 0; k < num_legs; k++) {
+        *account_balance(table, slots[k]) += legs[k].amount;
+    }
+    return 0;
+}
+
+long journal_replay(const char *filename, AccountTable *table, long skip) {
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) {
+        perror("Error opening journal file");
+        return -1;
+    }
+
+    BinaryHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, JOURNAL_MAGIC, 4) != 0) {
+        fprintf(stderr, "%s: not a journal file\n", filename);
+        fclose(file);
+        return -1;
+    }
+    if (header.version != BINARY_FORMAT_VERSION || header.record_size != sizeof(TransactionLog)) {
+        fprintf(stderr, "%s: unsupported journal version %u / record size %u\n",
+                filename, header.version, header.record_size);
+        fclose(file);
+        return -1;
+    }
+
+    // Çökme anında yarım kalmış son kayıt: dosya boyutu kayıt boyutunun katı değil
+    fseek(file, 0, SEEK_END);
+    long torn = (ftell(file) - (long)sizeof(header)) % (long)sizeof(TransactionLog);
+    if (torn != 0) {
+        fprintf(stderr, "Warning: ignoring %ld trailing bytes of an incomplete journal record\n", torn);
+    }
+
+    // Snapshot'a dahil olan kayıtlar atlanır
+    if (fseek(file, sizeof(header) + skip * (long)sizeof(TransactionLog), SEEK_SET) != 0) {
+        perror("fseek failed for journal file");
+        fclose(file);
+        return -1;
+    }
+
+    TransactionLog *batch = (TransactionLog *)malloc(JOURNAL_REPLAY_BATCH * sizeof(TransactionLog));
+    TransactionLog legs[MULTI_MAX_LEGS];  // Toplanmakta olan çok ayaklı işlemin ayakları
+    int expected_legs = 0;                // 0: çok ayaklı işlem toplanmıyor
+    int num_legs = 0;
+    int multi_id = 0;
+    long applied = 0;
+    size_t count;
+    while ((count = fread(batch, sizeof(TransactionLog), JOURNAL_REPLAY_BATCH, file)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            const TransactionLog *record = &batch[i];
+            if (expected_legs > 0) {
+                if (record->type == LEG_RECORD && record->transaction_id == multi_id) {
+                    legs[num_legs++] = *record;
+                    if (num_legs == expected_legs) {
+                        expected_legs = 0;
+                        if (replay_legs(legs, num_legs, table) == -1) {
+                            fprintf(stderr, "Warning: skipping journal record for transaction %d (unknown account or type)\n",
+                                    multi_id);
+                        } else {
+                            applied++;
+                        }
+                    }
+                    continue;
+                }
+                // Ayaklar ardışık yazılır; araya giren kayıt bozulma demektir
+                fprintf(stderr, "Warning: skipping incomplete multi-leg transaction %d in journal\n", multi_id);
+                expected_legs = 0;
+            }
+            if (record->type == MULTI_LEG) {
+                if (record->to_account < 1 || record->to_account > MULTI_MAX_LEGS) {
+                    fprintf(stderr, "Warning: skipping journal record for transaction %d (unknown account or type)\n",
+                            record->transaction_id);
+                    continue;
+                }
+                expected_legs = (int)record->to_account;
+                num_legs = 0;
+                multi_id = record->transaction_id;
+                continue;
+            }
+            if (replay_record(record, table) == -1) {
+                fprintf(stderr, "Warning: skipping journal record for transaction %d (unknown account or type)\n",
+                        record->transaction_id);
+                continue;
+            }
+            applied++;
+        }
+    }
+    if (expected_legs > 0) {
+        // Çökme ayakların bir kısmı diske inmişken oldu: işlem hiç uygulanmamış sayılır
+        fprintf(stderr, "Warning: ignoring multi-leg transaction %d with %d of %d legs at the end of the journal\n",
+                multi_id, num_legs, expected_legs);
+    }
+
+    free(batch);
+    fclose(file);
+    return applied;
+}
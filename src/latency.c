@@ -0,0 +1,88 @@
+#include "../include/latency.h"  // LatencyStats, LatencyHistogram
+#include "../include/utils.h"    // shared_alloc
+
+LatencyStats *latency_stats_create(int num_slots) {
+    size_t size = sizeof(LatencyStats) + (size_t)num_slots * sizeof(LatencyHistogram);
+    LatencyStats *stats = (LatencyStats *)shared_alloc(size, "latency stats");
+    if (stats == NULL) {
+        return NULL;
+    }
+
+    // Bellek sıfırlanmış gelir: tüm sayaçlar 0
+    stats->num_slots = num_slots;
+    return stats;
+}
+
+void latency_stats_destroy(LatencyStats *stats) {
+    shared_free(stats);
+}
+
+// Süreyi kova numarasına çevirir: küçük değerler birebir, sonrası 2'nin kuvveti
+// başına LATENCY_SUB_BUCKETS eşit genişlikte kova
+static int bucket_index(long ns) {
+    unsigned long v = ns < 0 ? 0 : (unsigned long)ns;
+    if (v < LATENCY_SUB_BUCKETS) {
+        return (int)v;
+    }
+    int msb = 63 - __builtin_clzl(v);
+    int shift = msb - LATENCY_SUB_BITS;
+    return (shift + 1) * LATENCY_SUB_BUCKETS + (int)((v >> shift) & (LATENCY_SUB_BUCKETS - 1));
+}
+
+// Kovanın orta noktası (nanosaniye)
+static long bucket_value(int index) {
+    if (index < LATENCY_SUB_BUCKETS) {
+        return index;
+    }
+    int shift = index / LATENCY_SUB_BUCKETS - 1;
+    long low = (long)(LATENCY_SUB_BUCKETS + index % LATENCY_SUB_BUCKETS) << shift;
+    return low + ((1L << shift) >> 1);
+}
+
+void latency_record(LatencyHistogram *histogram, long ns) {
+    __atomic_fetch_add(&histogram->buckets[bucket_index(ns)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&histogram->count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&histogram->total_ns, ns, __ATOMIC_RELAXED);
+
+    long max = __atomic_load_n(&histogram->max_ns, __ATOMIC_RELAXED);
+    while (ns > max && !__atomic_compare_exchange_n(&histogram->max_ns, &max, ns, 1,
+                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        // max başka process tarafından güncellendi, tekrar karşılaştır
+    }
+}
+
+void latency_merge(const LatencyStats *stats, LatencyHistogram *out) {
+    memset(out, 0, sizeof(*out));
+    for (int s = 0; s < stats->num_slots; s++) {
+        const LatencyHistogram *h = &stats->slots[s];
+        out->count += h->count;
+        out->total_ns += h->total_ns;
+        out->lock_wait_ns += h->lock_wait_ns;
+        if (h->max_ns > out->max_ns) {
+            out->max_ns = h->max_ns;
+        }
+        for (int b = 0; b < LATENCY_BUCKETS; b++) {
+            out->buckets[b] += h->buckets[b];
+        }
+    }
+}
+
+long latency_percentile(const LatencyHistogram *histogram, double q) {
+    if (histogram->count == 0) {
+        return 0;
+    }
+    // q oranındaki işlemin sırası (1'den başlar)
+    long rank = (long)(q * histogram->count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    long seen = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += histogram->buckets[b];
+        if (seen >= rank) {
+            long value = bucket_value(b);
+            return value < histogram->max_ns ? value : histogram->max_ns;
+        }
+    }
+    return histogram->max_ns;
+}
@@ -0,0 +1,174 @@
+#include "../include/client.h"   // BankClient
+#include "../include/ingest.h"   // TransactionReader
+#include "../include/latency.h"  // LatencyStats, now_ns
+#include "../include/utils.h"    // fork, waitpid, shmget
+
+// 🚚 bank-load: işlem dosyasını daemon'a (-D) birden fazla bağlantıdan, pipelining ile gönderir
+// Her bağlantı ayrı bir process'tir; dosyanın parçaları bağlantılara sırayla dağıtılır.
+// Gecikme, isteğin kuyruğa eklenmesinden cevabın okunmasına kadar geçen süredir.
+
+#define LOAD_DEFAULT_CONNECTIONS 4
+#define LOAD_DEFAULT_PIPELINE 256
+
+// Bağlantılara dağıtılan parça büyüklüğü (işlem)
+#define LOAD_BATCH 4096
+
+static void print_usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-c connections] [-p pipeline] -s SOCKET TRANSACTIONS_FILE\n"
+            "  -s PATH   Unix socket of the daemon (bank -D PATH)\n"
+            "  -c N      number of connections, one process each (default: %d)\n"
+            "  -p N      requests in flight per connection, at most %d (default: %d)\n",
+            prog, LOAD_DEFAULT_CONNECTIONS, WIRE_MAX_PIPELINE, LOAD_DEFAULT_PIPELINE);
+}
+
+// Bir cevabı okur, gecikmesini ve sonucunu kaydeder
+static int collect_reply(BankClient *client, const long *sent_ns, int pipeline,
+                         LatencyHistogram *histogram, long *failed) {
+    WireReply reply;
+    if (bank_client_receive(client, &reply) == -1) {
+        return -1;
+    }
+    latency_record(histogram, now_ns() - sent_ns[reply.tag % pipeline]);
+    if (reply.status != LOG_SUCCESS) {
+        (*failed)++;
+    }
+    return 0;
+}
+
+// Bir bağlantının process'i: connection. parçadan başlayarak her connections. parçayı gönderir
+static int run_connection(const char *socket_path, const char *filename, int connection, int connections,
+                          int pipeline, LatencyHistogram *histogram, long *failed) {
+    TransactionReader reader;
+    if (reader_open(&reader, filename) == -1) {
+        return -1;
+    }
+    BankClient *client = (BankClient *)malloc(sizeof(BankClient));
+    if (bank_client_connect(client, socket_path) == -1) {
+        free(client);
+        reader_close(&reader);
+        return -1;
+    }
+
+    Transaction *batch = (Transaction *)malloc(LOAD_BATCH * sizeof(Transaction));
+    long *sent_ns = (long *)malloc(pipeline * sizeof(long));  // tag % pipeline → gönderilme anı
+    int in_flight = 0;
+    int status = 0;
+    int count;
+    for (long b = 0; status == 0 && (count = reader_next_batch(&reader, batch, LOAD_BATCH)) > 0; b++) {
+        if (b % connections != connection) {
+            continue;  // Başka bağlantının parçası
+        }
+        for (int j = 0; j < count && status == 0; j++) {
+            // Pencere doluysa en eski cevabı bekle
+            if (in_flight == pipeline) {
+                status = collect_reply(client, sent_ns, pipeline, histogram, failed);
+                in_flight--;
+            }
+            long tag = bank_client_submit(client, &batch[j]);
+            if (tag == -1) {
+                status = -1;
+                break;
+            }
+            sent_ns[tag % pipeline] = now_ns();
+            in_flight++;
+        }
+    }
+    while (status == 0 && in_flight > 0) {
+        status = collect_reply(client, sent_ns, pipeline, histogram, failed);
+        in_flight--;
+    }
+
+    free(sent_ns);
+    free(batch);
+    bank_client_close(client);
+    free(client);
+    reader_close(&reader);
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    const char *socket_path = NULL;
+    int connections = LOAD_DEFAULT_CONNECTIONS;
+    int pipeline = LOAD_DEFAULT_PIPELINE;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:c:p:h")) != -1) {
+        switch (opt) {
+            case 's':
+                socket_path = optarg;
+                break;
+            case 'c':
+                connections = atoi(optarg);
+                break;
+            case 'p':
+                pipeline = atoi(optarg);
+                break;
+            default:
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (argc - optind != 1 || socket_path == NULL || connections < 1 || pipeline < 1 ||
+        pipeline > WIRE_MAX_PIPELINE) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char *filename = argv[optind];
+
+    // Bağlantı başına gecikme histogramı ve başarısız işlem sayacı (shared memory)
+    LatencyStats *stats = latency_stats_create(connections);
+    if (stats == NULL) {
+        return EXIT_FAILURE;
+    }
+    int shm_id = shmget(IPC_PRIVATE, connections * sizeof(long), IPC_CREAT | 0666);
+    if (shm_id == -1) {
+        perror("shmget failed for load counters");
+        return EXIT_FAILURE;
+    }
+    long *failed = (long *)shmat(shm_id, NULL, 0);
+    shmctl(shm_id, IPC_RMID, NULL);
+    if (failed == (void *)-1) {
+        perror("shmat failed for load counters");
+        return EXIT_FAILURE;
+    }
+
+    long start = now_ns();
+    fflush(stdout);
+    for (int c = 0; c < connections; c++) {
+        pid_t pid = fork();
+        if (pid == -1) {
+            perror("fork failed");
+            return EXIT_FAILURE;
+        } else if (pid == 0) {
+            int status = run_connection(socket_path, filename, c, connections, pipeline,
+                                        &stats->slots[c], &failed[c]);
+            _exit(status == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+    }
+    int exit_code = EXIT_SUCCESS;
+    for (int c = 0; c < connections; c++) {
+        int status;
+        if (wait(&status) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            exit_code = EXIT_FAILURE;  // Bağlantı koptu; diğerlerinin sonucu yine yazılır
+        }
+    }
+    double seconds = (now_ns() - start) / 1e9;
+
+    LatencyHistogram total;
+    latency_merge(stats, &total);
+    long total_failed = 0;
+    for (int c = 0; c < connections; c++) {
+        total_failed += failed[c];
+    }
+    printf("Load: %ld transactions over %d connections (pipeline %d) in %.3f s (%.0f transactions/s)\n",
+           total.count, connections, pipeline, seconds, seconds > 0 ? total.count / seconds : 0.0);
+    printf("Failed: %ld\n", total_failed);
+    printf("Latency (us): p50 %.2f, p99 %.2f, p99.9 %.2f, max %.2f\n",
+           latency_percentile(&total, 0.50) / 1e3, latency_percentile(&total, 0.99) / 1e3,
+           latency_percentile(&total, 0.999) / 1e3, total.max_ns / 1e3);
+
+    shmdt(failed);
+    latency_stats_destroy(stats);
+    return exit_code;
+}
@@ -0,0 +1,294 @@
+#include "../include/locks.h"   // LockSet ve AccountLock tanımları
+#include "../include/utils.h"   // sem_p / sem_v, futex_wait / futex_wake
+#include "../include/latency.h" // now_ns
+
+// Futex'e düşmeden önce kaç kez denensin? (kısa kritik bölgeler için dönmek daha ucuz)
+#define LOCK_SPIN_LIMIT 100
+
+size_t lock_area_size(int max_accounts) {
+#ifdef ACCOUNT_LAYOUT_PADDED
+    return sizeof(LockCounters);  // Kilitler hesap satırlarında
+#else
+    return sizeof(LockCounters) + (size_t)max_accounts * sizeof(AccountLock);
+#endif
+}
+
+// Slot'un futex kilidi (LAYOUT=padded: bakiyeyle aynı cache line'da)
+static inline AccountLock *lock_word(const LockSet *lock_set, int slot) {
+#ifdef ACCOUNT_LAYOUT_PADDED
+    return &lock_set->lines[slot].lock;
+#else
+    return &lock_set->locks[slot];
+#endif
+}
+
+// Kernel'in bir sete izin verdiği en fazla semaphore sayısı (SEMMSL)
+static int read_semmsl(void) {
+    int semmsl = 0;
+    FILE *file = fopen("/proc/sys/kernel/sem", "r");
+    if (file != NULL) {
+        if (fscanf(file, "%d", &semmsl) != 1) {
+            semmsl = 0;
+        }
+        fclose(file);
+    }
+    return semmsl > 0 ? semmsl : 250;  // Okunamazsa eski varsayılan sınır
+}
+
+int init_lock_set(LockSet *lock_set, LockBackend backend, void *lock_area, const AccountTable *table) {
+    int num_accounts = table->num_accounts;
+    lock_set->backend = backend;
+    lock_set->sem_ids = NULL;
+    lock_set->num_sem_sets = 0;
+    lock_set->sems_per_set = 0;
+    lock_set->counters = (LockCounters *)lock_area;
+    lock_set->locks = (AccountLock *)((char *)lock_area + sizeof(LockCounters));
+#ifdef ACCOUNT_LAYOUT_PADDED
+    lock_set->locks = NULL;
+    lock_set->lines = table->lines;
+#endif
+    lock_set->lock_free_single = 0;
+    lock_set->wait_ns = NULL;
+#ifdef BANK_STATS
+    lock_set->stats = NULL;
+#endif
+    lock_set->counters->semops_saved = 0;
+
+    if (backend == LOCK_SEM) {
+        // Tek set SEMMSL'den fazla semaphore alamaz: hesapları setlere böl
+        int per_set = read_semmsl();
+        int num_sets = (num_accounts + per_set - 1) / per_set;
+        lock_set->sems_per_set = per_set;
+        lock_set->sem_ids = (int *)malloc(num_sets * sizeof(int));
+
+        // Her semaphore 1 (açık) olarak başlar; set başına tek SETALL çağrısı
+        unsigned short *values = (unsigned short *)malloc(per_set * sizeof(unsigned short));
+        for (int i = 0; i < per_set; i++) {
+            values[i] = 1;
+        }
+
+        for (int set = 0; set < num_sets; set++) {
+            int count = num_accounts - set * per_set < per_set ? num_accounts - set * per_set : per_set;
+            int sem_id = semget(IPC_PRIVATE, count, IPC_CREAT | 0666);
+            if (sem_id == -1) {
+                perror("semget failed");
+                free(values);
+                destroy_lock_set(lock_set);
+                return -1;
+            }
+            lock_set->sem_ids[set] = sem_id;
+            lock_set->num_sem_sets++;
+
+            union semun arg;
+            arg.array = values;
+            if (semctl(sem_id, 0, SETALL, arg) == -1) {
+                perror("Failed to initialize semaphore");
+                free(values);
+                destroy_lock_set(lock_set);
+                return -1;
+            }
+        }
+        free(values);
+    } else if (backend == LOCK_FUTEX) {
+        // Shared memory önceki çalıştırmadan kalmış olabilir, tüm kilitleri aç
+        for (int i = 0; i < num_accounts; i++) {
+            lock_word(lock_set, i)->state = 0;
+        }
+    }
+    return 0;
+}
+
+void destroy_lock_set(LockSet *lock_set) {
+    if (lock_set->backend == LOCK_SEM && lock_set->sem_ids != NULL) {
+        for (int set = 0; set < lock_set->num_sem_sets; set++) {
+            semctl(lock_set->sem_ids[set], 0, IPC_RMID);
+        }
+        free(lock_set->sem_ids);
+        lock_set->sem_ids = NULL;
+        lock_set->num_sem_sets = 0;
+    }
+}
+
+// Futex kilidi (Drepper, "Futexes Are Tricky" - mutex 3)
+// Çekişme yoksa tek bir CAS ile alınır, kernel'e girilmez
+static void futex_lock(int *state) {
+    int c = 0;
+
+    // Önce kısa bir süre dön: kilit az sonra boşalacaksa uyumaya gerek yok
+    for (int spin = 0; spin < LOCK_SPIN_LIMIT; spin++) {
+        c = 0;
+        if (__atomic_compare_exchange_n(state, &c, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return;  // 0 → 1: kilit alındı
+        }
+        cpu_relax();
+    }
+
+    // Hâlâ kilitli: "bekleyen var" (2) işaretle ve futex üzerinde uyu
+    if (c != 2) {
+        c = __atomic_exchange_n(state, 2, __ATOMIC_ACQUIRE);
+    }
+    while (c != 0) {
+        futex_wait(state, 2);
+        c = __atomic_exchange_n(state, 2, __ATOMIC_ACQUIRE);
+    }
+}
+
+static void futex_unlock(int *state) {
+    // 1 → 0 ise bekleyen yok, sistem çağrısı yapma
+    if (__atomic_fetch_sub(state, 1, __ATOMIC_RELEASE) != 1) {
+        __atomic_store_n(state, 0, __ATOMIC_RELEASE);
+        futex_wake(state, 1);  // Bekleyenlerden birini uyandır
+    }
+}
+
+// Kilidi beklemeden almayı bir kez dener (futex_lock'un hızlı yolu)
+static inline int futex_try_lock(int *state) {
+    int c = 0;
+    return __atomic_compare_exchange_n(state, &c, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+// Tek bir futex kilidini alır; STATS=1 derlemesinde hesabın sayaçlarını da günceller
+static inline void futex_lock_slot(LockSet *lock_set, int slot) {
+#ifdef BANK_STATS
+    if (lock_set->stats != NULL) {
+        int *state = &lock_word(lock_set, slot)->state;
+        if (futex_try_lock(state)) {
+            account_stats_acquired(lock_set->stats, slot, 0, 0);
+        } else {
+            long start = now_ns();
+            futex_lock(state);
+            account_stats_acquired(lock_set->stats, slot, 1, now_ns() - start);
+        }
+        return;
+    }
+#endif
+    futex_lock(&lock_word(lock_set, slot)->state);
+}
+
+// Aynı setteki semaphore'ları tek semop() ile alır; STATS=1 derlemesinde önce
+// beklemeden dener, dolu ise bekleme süresi kümedeki her hesaba yazılır
+// slots: nums'daki semaphore'ların hesap slot'ları
+static void sem_lock_batch(LockSet *lock_set, int set, const int *nums, const int *slots, int count) {
+#ifdef BANK_STATS
+    if (lock_set->stats != NULL) {
+        int contended = 0;
+        long wait_ns = 0;
+        if (sem_try_p_batch(lock_set->sem_ids[set], nums, count) == -1) {
+            long start = now_ns();
+            sem_p_batch(lock_set->sem_ids[set], nums, count);
+            contended = 1;
+            wait_ns = now_ns() - start;
+        }
+        for (int i = 0; i < count; i++) {
+            account_stats_acquired(lock_set->stats, slots[i], contended, wait_ns);
+        }
+        return;
+    }
+#endif
+    (void)slots;
+    sem_p_batch(lock_set->sem_ids[set], nums, count);
+}
+
+// Ölçüm açıksa kilit bekleme süresini sayaca ekler
+static void add_wait(LockSet *lock_set, long start) {
+    __atomic_fetch_add(lock_set->wait_ns, now_ns() - start, __ATOMIC_RELAXED);
+}
+
+void lock_account(LockSet *lock_set, int slot) {
+    if (lock_set->backend == LOCK_NONE) {
+        return;
+    }
+    long start = lock_set->wait_ns != NULL ? now_ns() : 0;
+    if (lock_set->backend == LOCK_SEM) {
+        int num = slot % lock_set->sems_per_set;
+        sem_lock_batch(lock_set, slot / lock_set->sems_per_set, &num, &slot, 1);
+    } else {
+        futex_lock_slot(lock_set, slot);
+    }
+    if (lock_set->wait_ns != NULL) {
+        add_wait(lock_set, start);
+    }
+}
+
+void unlock_account(LockSet *lock_set, int slot) {
+    if (lock_set->backend == LOCK_SEM) {
+        sem_v(lock_set->sem_ids[slot / lock_set->sems_per_set], slot % lock_set->sems_per_set);
+    } else if (lock_set->backend == LOCK_FUTEX) {
+        futex_unlock(&lock_word(lock_set, slot)->state);
+    }
+}
+
+// Küçük kümeler için ekleme sıralaması; ardından tekrar edenleri atar
+static int sort_unique(int *slots, int n) {
+    for (int i = 1; i < n; i++) {
+        int key = slots[i];
+        int j = i - 1;
+        while (j >= 0 && slots[j] > key) {
+            slots[j + 1] = slots[j];
+            j--;
+        }
+        slots[j + 1] = key;
+    }
+    int unique = 0;
+    for (int i = 0; i < n; i++) {
+        if (unique == 0 || slots[unique - 1] != slots[i]) {
+            slots[unique++] = slots[i];
+        }
+    }
+    return unique;
+}
+
+// Sıralı slot kümesine semaphore işlemini uygular: aynı setteki ardışık slot'lar
+// (en fazla SEM_BATCH_MAX) tek semop() ile, setler artan sırayla
+static void sem_apply_set(LockSet *lock_set, const int *slots, int n, int lock) {
+    int per_set = lock_set->sems_per_set;
+    int nums[SEM_BATCH_MAX];
+    long saved = 0;
+
+    int i = 0;
+    while (i < n) {
+        int set = slots[i] / per_set;
+        int count = 0;
+        while (i < n && count < SEM_BATCH_MAX && slots[i] / per_set == set) {
+            nums[count++] = slots[i] % per_set;
+            i++;
+        }
+        if (lock) {
+            sem_lock_batch(lock_set, set, nums, &slots[i - count], count);
+        } else {
+            sem_v_batch(lock_set->sem_ids[set], nums, count);
+        }
+        saved += count - 1;
+    }
+    __atomic_fetch_add(&lock_set->counters->semops_saved, saved, __ATOMIC_RELAXED);
+}
+
+int lock_account_set(LockSet *lock_set, int *slots, int n) {
+    if (lock_set->backend == LOCK_NONE) {
+        return n;  // Kilit yok; unlock_account_set() de hiçbir şey yapmaz
+    }
+    long start = lock_set->wait_ns != NULL ? now_ns() : 0;
+    n = sort_unique(slots, n);
+
+    if (lock_set->backend == LOCK_SEM) {
+        sem_apply_set(lock_set, slots, n, 1);
+    } else {
+        for (int i = 0; i < n; i++) {
+            futex_lock_slot(lock_set, slots[i]);  // Artan slot sırası
+        }
+    }
+    if (lock_set->wait_ns != NULL) {
+        add_wait(lock_set, start);
+    }
+    return n;
+}
+
+void unlock_account_set(LockSet *lock_set, const int *slots, int n) {
+    if (lock_set->backend == LOCK_SEM) {
+        sem_apply_set(lock_set, slots, n, 0);
+    } else if (lock_set->backend == LOCK_FUTEX) {
+        for (int i = 0; i < n; i++) {
+            futex_unlock(&lock_word(lock_set, slots[i])->state);
+        }
+    }
+}
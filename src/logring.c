@@ -0,0 +1,93 @@
+#include "../include/logring.h"  // LogRing
+#include "../include/utils.h"    // shared_alloc
+
+// Halkayı worker'ların belleğinde (shared_alloc) veya her zaman shared memory'de (shm_alloc) yaratır
+size_t log_ring_size(long capacity) {
+    return sizeof(LogRing) + capacity * sizeof(TransactionLog);
+}
+
+static LogRing *create_ring(long capacity, int process_shared) {
+    size_t size = log_ring_size(capacity);
+    LogRing *ring = (LogRing *)(process_shared ? shm_alloc(size, "transaction log")
+                                               : shared_alloc(size, "transaction log"));
+    if (ring == NULL) {
+        return NULL;
+    }
+
+    // Bellek sıfırlanmış gelir: tüm yuvalar LOG_EMPTY
+    ring->tail = 0;
+    ring->head = 0;
+    ring->capacity = capacity;
+    ring->process_shared = process_shared;
+    return ring;
+}
+
+LogRing *log_ring_create(long capacity) {
+    return create_ring(capacity, 0);
+}
+
+LogRing *log_ring_create_shared(long capacity) {
+    return create_ring(capacity, 1);
+}
+
+void log_ring_destroy(LogRing *ring) {
+    if (ring == NULL) {
+        return;  // Daemon modunda halka yok
+    }
+    if (ring->process_shared) {
+        shm_free(ring);
+    } else {
+        shared_free(ring);
+    }
+}
+
+// pos yuvası boşalana kadar bekler ve kaydı yazar
+// (çağıranlar halkayı okunmamış kayıt capacity'yi geçmeyecek şekilde boyutlandırır)
+static void write_entry(LogRing *ring, long pos, int transaction_id, int type, int64_t from_account,
+                        int64_t to_account, int amount, int status) {
+    // Halka doluysa okuyucunun bu yuvayı boşaltmasını bekle
+    while (pos - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) >= ring->capacity) {
+        sched_yield();
+    }
+
+    TransactionLog *entry = &ring->entries[pos % ring->capacity];
+    entry->transaction_id = transaction_id;
+    entry->from_account = from_account;
+    entry->to_account = to_account;
+    entry->amount = amount;
+    entry->type = (unsigned char)type;
+    // status en son: okuyucu bunu gördüğünde diğer alanlar da yazılmış olur
+    __atomic_store_n(&entry->status, (unsigned char)status, __ATOMIC_RELEASE);
+}
+
+long log_append(LogRing *ring, int transaction_id, int type, int64_t from_account,
+                int64_t to_account, int amount, int status) {
+    // Yuva ayır: tek bir atomik fetch-add, yazanlar arasında başka senkronizasyon yok
+    long pos = __atomic_fetch_add(&ring->tail, 1, __ATOMIC_RELAXED);
+    write_entry(ring, pos, transaction_id, type, from_account, to_account, amount, status);
+    return pos;
+}
+
+long log_append_group(LogRing *ring, const TransactionLog *records, int count) {
+    long pos = __atomic_fetch_add(&ring->tail, count, __ATOMIC_RELAXED);
+    for (int k = 0; k < count; k++) {
+        write_entry(ring, pos + k, records[k].transaction_id, records[k].type, records[k].from_account,
+                    records[k].to_account, records[k].amount, records[k].status);
+    }
+    return pos;
+}
+
+int log_ring_pop(LogRing *ring, TransactionLog *out) {
+    TransactionLog *entry = &ring->entries[ring->head % ring->capacity];
+    unsigned char status = __atomic_load_n(&entry->status, __ATOMIC_ACQUIRE);
+    if (status == LOG_EMPTY) {
+        return 0;
+    }
+
+    *out = *entry;
+    out->status = status;
+    entry->status = LOG_EMPTY;
+    // Yuva boşaldı: bekleyen yazan varsa devam edebilir
+    __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+    return 1;
+}
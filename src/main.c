@@ -1,20 +1,830 @@
 #include "../include/accounts.h"
 #include "../include/transactions.h"
 #include "../include/utils.h"
+#include "../include/config.h"
+#include "../include/pool.h"
+#include "../include/ingest.h"
+#include "../include/logring.h"
+#include "../include/journal.h"
+#include "../include/snapshot.h"
+#include "../include/binfmt.h"
+#include "../include/account_table.h"
+#include "../include/latency.h"
+#include "../include/contention.h"
+#include "../include/scheduler.h"
+#include "../include/aggregate.h"
+#include "../include/placement.h"
+#include "../include/retry.h"
+#include "../include/server.h"
+#include <sys/socket.h>  // accept
+#include <signal.h>      // kill
 
-#define MAX_ACCOUNTS 100                 // Maksimum hesap sayisi
-#define MAX_TRANSACTIONS 1000            // Maksimum islem sayisi
-#define ACCOUNTS_FILE "accounts.txt"      // Hesap bilgisi dosyasi
-#define TRANSACTIONS_FILE "transactions.txt"  // Islem bilgisi dosyasi
+#define FORK_MAX_CHILDREN 1000  // -m fork: ayni anda calisan en fazla child process (eski MAX_TRANSACTIONS)
 
-int main() {
-    // IPC key'leri olusturuluyor
-    // ftok benzersiz anahtar oluşturur (farklı programlar arasında çakışmaması için )
-    key_t shm_key = ftok(".", 'S');   // Shared memory key
-    key_t sem_key = ftok(".", 'M');   // Semaphore key
+// -q: transaction log, tekrar denemeler ve bakiyeler yazdirilmaz (benchmark icin)
+static int quiet = 0;
+
+// Yeniden denenecek basarisiz islem (pool modunda parca geri kullanildigi icin islem kopyalanir)
+// failed_ns: Basarisizligin goruldugu an (-r: tekrar deneme gecikmesi buradan olculur)
+// legs: Cok ayakli islemin ayaklarinin kopyasi (txn.from_account 0), diger turlerde NULL
+typedef struct {
+    int transaction_id;
+    Transaction txn;
+    long failed_ns;
+    Leg *legs;
+} FailedTransaction;
+
+// Basarisiz islemlerin buyuyebilen listesi
+typedef struct {
+    FailedTransaction *items;
+    int count;
+    int capacity;
+} FailedList;
+
+// legs: Islemin okundugu partinin ayak dizisi (sadece MULTI_LEG icin kopyalanir)
+static void add_failed(FailedList *list, int transaction_id, const Transaction *txn, const Leg *legs) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity == 0 ? 64 : list->capacity * 2;
+        list->items = (FailedTransaction *)realloc(list->items, list->capacity * sizeof(FailedTransaction));
+    }
+    FailedTransaction *item = &list->items[list->count];
+    item->transaction_id = transaction_id;
+    item->txn = *txn;
+    item->failed_ns = now_ns();
+    item->legs = NULL;
+    if (txn->type == MULTI_LEG && legs != NULL) {
+        item->legs = (Leg *)malloc(txn->to_account * sizeof(Leg));
+        memcpy(item->legs, legs + txn->from_account, txn->to_account * sizeof(Leg));
+        item->txn.from_account = 0;
+    }
+    list->count++;
+}
+
+static void free_failed(FailedList *list) {
+    for (int j = 0; j < list->count; j++) {
+        free(list->items[j].legs);
+    }
+    free(list->items);
+}
+
+// Tek bir log kaydını ekrana yazar (tür ve durum kodları burada metne çevrilir)
+static void print_log_entry(const TransactionLog *log) {
+    if (quiet) {
+        return;
+    }
+    const char *status = log->status == LOG_SUCCESS ? "Success" : "Failed";
+    switch (log->type) {
+        case DEPOSIT:
+            printf("Transaction %d: Deposit %d to Account %lld (%s)\n",
+                   log->transaction_id, log->amount, (long long)log->to_account, status);
+            break;
+        case WITHDRAW:
+            printf("Transaction %d: Withdraw %d from Account %lld (%s)\n",
+                   log->transaction_id, log->amount, (long long)log->from_account, status);
+            break;
+        case TRANSFER:
+            printf("Transaction %d: Transfer %d from Account %lld to Account %lld (%s)\n",
+                   log->transaction_id, log->amount, (long long)log->from_account,
+                   (long long)log->to_account, status);
+            break;
+        case MULTI_LEG:
+            printf("Transaction %d: Multi-leg %d from Account %lld over %lld legs (%s)\n",
+                   log->transaction_id, log->amount, (long long)log->from_account,
+                   (long long)log->to_account, status);
+            break;
+        default:
+            break;  // Bilinmeyen işlem türü yazdırılmaz
+    }
+}
+
+// Final hesap bakiyelerini yazdırır
+static void print_final_balances(const AccountTable *table) {
+    if (quiet) {
+        return;
+    }
+    printf("\nFinal account balances:\n");
+    for (int i = 0; i < table->num_accounts; i++) {
+        printf("Account %lld: %d\n", (long long)table->accounts[i].account_id, *account_balance(table, i));
+    }
+}
+
+// Tekrar denenen tek işlemin log kaydını halkadan alıp yazar
+static void print_next_log(LogRing *logs) {
+    TransactionLog entry;
+    while (!log_ring_pop(logs, &entry)) {
+        sched_yield();  // Kayıt yazılmak üzere
+    }
+    print_log_entry(&entry);
+}
+
+// Eski yöntem: tüm dosyayı okur, her transaction için ayrı child process yaratir ve hepsini bekler
+// (aynı anda en fazla FORK_MAX_CHILDREN child). Karşılaştırma için saklanıyor (-m fork)
+// logs_out: Tekrar denemelerde kullanılacak log halkası (çağıran log_ring_destroy ile kapatır)
+// stats: NULL değilse child'lar işlem sürelerini ilk histograma yazar
+// Dönüş: İşlem sayısı (hiç işlem yoksa 0, dosya okunamazsa veya fork başarısız olursa -1)
+static int run_forked(const char *filename, AccountTable *table, LockSet *locks, LogRing **logs_out,
+                      FailedList *failed, LatencyStats *stats) {
+    // Transaction dosyasini oku
+    Transaction *txns = NULL;
+    Leg *legs = NULL;
+    int num_transactions = read_transactions(filename, &txns, &legs);
+    if (num_transactions <= 0) {
+        free(txns);
+        free(legs);
+        return num_transactions;
+    }
+
+    // Transaction log halkasi: child'lar bitene kadar okunmadigi icin her isleme bir yuva
+    LogRing *logs = log_ring_create(num_transactions);
+    if (logs == NULL) {
+        exit(EXIT_FAILURE);
+    }
+    *logs_out = logs;
+
+    // Çalışan child'lar: running[k] PID'si, running_ids[k] çalıştırdığı işlemin ID'si
+    pid_t running[FORK_MAX_CHILDREN];
+    int running_ids[FORK_MAX_CHILDREN];
+    int num_running = 0;
+    int launched = 0;      // Child'ı yaratılan işlem sayısı
+    int aborted = 0;       // fork veya wait başarısız: yeni child yaratılmaz, çalışanlar beklenir
+
+    // Fork öncesi tamponu boşalt, yoksa child'lar aynı çıktıyı tekrar yazar
+    fflush(stdout);
+
+    // Her transaction için child process yarat; en fazla FORK_MAX_CHILDREN tanesi aynı anda çalışır
+    while ((launched < num_transactions && !aborted) || num_running > 0) {
+        if (launched < num_transactions && !aborted && num_running < FORK_MAX_CHILDREN) {
+            pid_t pid = fork();
+
+            if (pid == -1) {
+                perror("fork failed");
+                aborted = 1;
+                continue;
+            }
+            else if (pid == 0) {  // Child process
+                long start = 0;
+                if (stats != NULL) {
+                    locks->wait_ns = &stats->slots[0].lock_wait_ns;
+                    start = now_ns();
+                }
+                int result = execute_transaction(table, logs, &txns[launched], legs, launched, locks);
+                if (stats != NULL) {
+                    latency_record(&stats->slots[0], now_ns() - start);
+                }
+                exit(result);  // Çıkış kodu: 0 (başarı) veya -1 (hata)
+            }
+            running[num_running] = pid;
+            running_ids[num_running] = launched;
+            num_running++;
+            launched++;
+            continue;
+        }
+
+        // Sınıra ulaşıldı veya yaratılacak işlem kalmadı: bir child'ın bitmesini bekle
+        int status;
+        pid_t finished_pid = wait(&status);
+        if (finished_pid == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("wait failed");
+            aborted = 1;
+            break;
+        }
+
+        // Hangi işlem tamamlandı? (journal yazıcısı da child'dır, listede yoksa atlanır)
+        for (int k = 0; k < num_running; k++) {
+            if (running[k] != finished_pid) {
+                continue;
+            }
+            int i = running_ids[k];
+            running[k] = running[num_running - 1];
+            running_ids[k] = running_ids[num_running - 1];
+            num_running--;
+
+            // Başarısız işlemleri kaydet
+            if (WIFEXITED(status) && WEXITSTATUS(status) != SUCCESS) {
+                add_failed(failed, i, &txns[i], legs);
+                if (!quiet) {
+                    printf("Debug: Transaction %d failed with exit code %d\n", i, WEXITSTATUS(status));  // Hata ayıklama çıktısı
+                }
+            }
+            break;
+        }
+    }
+
+    // Yarım kalan çalışma yazdırılmaz; çalışan child'lar beklendi, çağıran hesap
+    // segmentini ve kilitleri bırakır
+    if (aborted) {
+        fprintf(stderr, "Stopped after %d of %d transactions\n", launched, num_transactions);
+        log_ring_destroy(logs);
+        *logs_out = NULL;
+        free(txns);
+        free(legs);
+        return -1;
+    }
+
+    // Kayıtlar halkaya bitiş sırasıyla eklendi; işlem ID'sine göre sırala
+    TransactionLog *ordered = (TransactionLog *)malloc(num_transactions * sizeof(TransactionLog));
+    TransactionLog entry;
+    while (log_ring_pop(logs, &entry)) {
+        ordered[entry.transaction_id] = entry;
+    }
+
+    // Transaction log yazdır (ilk çalıştırma)
+    if (!quiet) {
+        printf("\nTransaction Log:\n");
+    }
+    for (int i = 0; i < num_transactions; i++) {
+        print_log_entry(&ordered[i]);
+    }
+
+    free(ordered);
+    free(txns);
+    free(legs);
+    return num_transactions;
+}
+
+// Eski yöntem: başarısız işlemi yeni bir child process ile bir kez daha dener
+static int retry_forked(const FailedTransaction *item, AccountTable *table, LogRing *logs, LockSet *locks) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("fork failed");
+        exit(EXIT_FAILURE);
+    } else if (pid == 0) {
+        int result = execute_transaction(table, logs, &item->txn, item->legs, item->transaction_id, locks);
+        exit(result);
+    }
+
+    // Yeniden denenen işlemin tamamlanmasını bekle
+    int status;
+    wait(&status);
+
+    // Yeniden denenen işlemin sonucu
+    int retry_result = FAILURE;
+    if (WIFEXITED(status)) {
+        retry_result = WEXITSTATUS(status);
+    }
+    return retry_result;
+}
+
+// Log kaydının emekliye ayrılmamış parçalardaki yeri: slot * CHUNK_SIZE + parçadaki yeri
+// Tekrar deneme parçasının ID'leri artan sıradadır ve emekliye ayrılmış parçalardan
+// geldiği için yayındaki normal parçaların ID'leriyle çakışmaz
+static int log_place(const WorkQueue *queue, long retired, long published, int transaction_id) {
+    for (long p = retired; p < published; p++) {
+        int slot = (int)(p % CHUNK_SLOTS);
+        const Chunk *chunk = &queue->chunks[slot];
+        if (!chunk->retry) {
+            if (transaction_id >= chunk->base_id && transaction_id < chunk->base_id + chunk->count) {
+                return slot * CHUNK_SIZE + transaction_id - chunk->base_id;
+            }
+            continue;
+        }
+        int low = 0;
+        int high = chunk->count - 1;
+        while (low <= high) {
+            int mid = (low + high) / 2;
+            if (chunk->ids[mid] == transaction_id) {
+                return slot * CHUNK_SIZE + mid;
+            }
+            if (chunk->ids[mid] < transaction_id) {
+                low = mid + 1;
+            } else {
+                high = mid - 1;
+            }
+        }
+    }
+    return -1;  // Olmamalı: her kayıt yayındaki bir parçanın işlemidir
+}
 
-    // Hesaplar icin shared memory yarat
-    int accounts_shm_id = shmget(shm_key, MAX_ACCOUNTS * sizeof(Account), IPC_CREAT | 0666);
+// Worker pool ile dosyayı parça parça işler: ana process mmap ile parse edip parçaları
+// yayınlarken worker'lar önceki parçaları çalıştırır; biten parçalar sırayla loglanır
+// logs_out: Tekrar denemelerde kullanılacak log halkası (çağıran log_ring_destroy ile kapatır)
+// snapshots: NULL değilse worker'lar çalışırken periyodik snapshot alınır
+// audits: NULL değilse worker'lar çalışırken periyodik olarak tutarlı bakiye toplamı alınır
+// stats: NULL değilse worker'lar işlem sürelerini kendi histogramlarına yazar
+// scheduler: NULL değilse (-m sched / -m ordered) her parça yayınlanmadan önce hazırlanır
+// deposits: NULL değilse (-d) her parçanın yatırmaları zamanlamadan önce ön toplanır
+// placement: NULL değilse (-p / -N) worker'lar sabitlenir, log halkası node'lara dağıtılır
+// retries: NULL değilse (-r, -m pool) başarısız işlemler parçaları emekliye ayrılırken
+//          kuyruğa girer ve bakiyesi yetenler çalışma sürerken worker'lara verilir
+// Dönüş: İşlem sayısı (hiç işlem yoksa 0, dosya okunamazsa -1)
+static int run_pool(const Config *config, AccountTable *table, LockSet *locks, LogRing **logs_out,
+                    FailedList *failed, Snapshotter *snapshots, Auditor *audits,
+                    LatencyStats *stats, Scheduler *scheduler, DepositAggregator *deposits,
+                    Placement *placement, RetryQueue *retries) {
+    TransactionReader reader;
+    if (reader_open(&reader, config->transactions_file) == -1) {
+        return -1;
+    }
+
+    // İş kuyruğu için paylaşılan bellek (parçalar ve sonuçlar burada tutulur)
+    WorkQueue *queue = (WorkQueue *)shared_alloc(sizeof(WorkQueue), "work queue");
+    if (queue == NULL) {
+        exit(EXIT_FAILURE);
+    }
+    work_queue_init(queue);
+    queue->engine = config->engine;
+    queue->stats = stats;
+    queue->placement = placement;
+    if (scheduler != NULL) {
+        queue->schedule = scheduler->kind;  // Dalgalar / siralar kilitsiz calisir
+        queue->turns = scheduler->turns;
+    }
+
+    // Log halkası: okunmamış kayıtlar her zaman henüz emekliye ayrılmamış parçalara aittir,
+    // bu yüzden CHUNK_SLOTS * CHUNK_SIZE yuva yeterlidir ve worker'lar hiç beklemez
+    LogRing *logs = log_ring_create((long)CHUNK_SLOTS * CHUNK_SIZE);
+    if (logs == NULL) {
+        exit(EXIT_FAILURE);
+    }
+    *logs_out = logs;
+    if (placement != NULL) {
+        // Kayitlari her worker yazar, ana process okur: tek bir node'a ait degil
+        placement_interleave(placement, logs, log_ring_size(logs->capacity));
+    }
+
+    // Halkadan gelen kayıtlar parçadaki yerlerine konur (log_place)
+    TransactionLog *ordered = (TransactionLog *)malloc(CHUNK_SLOTS * CHUNK_SIZE * sizeof(TransactionLog));
+    int collected[CHUNK_SLOTS] = { 0 };  // Parça başına halkadan alınmış kayıt sayısı
+
+    // -m shard: her worker ardisik bir hesap araliginin sahibi, isler kuyruklarla gelir
+    ShardSet shard_set;
+    if (config->mode == MODE_SHARD) {
+        if (shard_set_create(&shard_set, config->num_workers, table) == -1) {
+            exit(EXIT_FAILURE);
+        }
+        queue->shards = &shard_set;
+    }
+
+    // Periyodik snapshot ve denetim: worker'lar her işlemi epoch kapısından geçerek çalıştırır
+    // (-m shard: yolda olan alacaklar yüzünden tutarlı an yok, sadece sonda snapshot alınır)
+    // -c: aynı hesaba kilitsiz yazan işlemler yüzünden kesit kapı kapatılarak alınır
+    SnapshotGate *gate = NULL;
+    if (((snapshots != NULL && snapshots->interval_ms > 0) || audits != NULL) &&
+        config->mode != MODE_SHARD) {
+        gate = snapshot_gate_create(config->num_workers, locks->lock_free_single);
+        if (gate == NULL) {
+            exit(EXIT_FAILURE);
+        }
+        queue->gate = gate;
+    }
+
+    int started = start_worker_pool(queue, config->num_workers, table, logs, locks);
+    if (started == 0) {
+        exit(EXIT_FAILURE);
+    }
+
+    long published = 0;     // Yayınlanan parça sayısı
+    long retired = 0;       // Sonucu işlenmiş parça sayısı
+    int num_transactions = 0;
+    int end_of_file = 0;
+    int retry_in_flight = 0;  // -r: yayınlanmış tekrar deneme parçası var (aynı anda en fazla bir)
+
+    while (!end_of_file || retired < published) {
+        // Zamanı geldiyse snapshot / denetim (worker'lar epoch ilerlerken çalışmaya devam eder)
+        if (gate != NULL && snapshots != NULL && snapshot_due(snapshots)) {
+            snapshot_take(snapshots, gate);
+        }
+        if (gate != NULL && audits != NULL && audit_due(audits)) {
+            audit_take(audits, gate);
+        }
+
+        // Boş yer varsa bir sonraki parçayı parse et (worker'lar bu sırada çalışmaya devam eder)
+        if (!end_of_file && published - retired < CHUNK_SLOTS) {
+            Chunk *chunk = &queue->chunks[published % CHUNK_SLOTS];
+            reader.legs = chunk->legs;
+            int count = reader_next_batch(&reader, chunk->txns, CHUNK_SIZE);
+            if (count > 0) {
+                collected[published % CHUNK_SLOTS] = 0;
+                chunk->base_id = num_transactions;
+                chunk->retry = 0;
+                num_transactions += count;
+                chunk->aggregated = deposits != NULL;
+                if (deposits != NULL) {
+                    aggregate_deposits(deposits, chunk->txns, chunk->legs, count, chunk->deposit_total);
+                }
+                if (scheduler != NULL) {
+                    schedule_chunk(scheduler, chunk, count);
+                }
+                publish_chunk(queue, chunk, count);
+                published++;
+            }
+            if (count < CHUNK_SIZE) {
+                end_of_file = 1;
+                finish_work_queue(queue);
+            }
+            continue;
+        }
+
+        // En eski parçanın bitmesini bekle, logunu yazdır ve yerini boşalt
+        Chunk *chunk = &queue->chunks[retired % CHUNK_SLOTS];
+        wait_chunk(chunk);
+
+        // Parçanın tüm kayıtları halkadan alınana kadar oku; sonraki parçaların kayıtları
+        // da kendi yerlerine konur. Yuvası ayrılıp henüz yazılmamış kayıt varsa kısa bekle.
+        int slot = (int)(retired % CHUNK_SLOTS);
+        TransactionLog entry;
+        while (collected[slot] < chunk->count) {
+            if (!log_ring_pop(logs, &entry)) {
+                sched_yield();
+                continue;
+            }
+            int index = log_place(queue, retired, published, entry.transaction_id);
+            ordered[index] = entry;
+            collected[index / CHUNK_SIZE]++;
+        }
+
+        if (retired == 0 && !quiet) {
+            printf("\nTransaction Log:\n");
+        }
+        TransactionLog *chunk_logs = &ordered[slot * CHUNK_SIZE];
+        if (chunk->retry) {
+            if (!quiet) {
+                printf("Retry round %ld: %d transactions\n", retries->rounds, chunk->count);
+            }
+            for (int j = 0; j < chunk->count; j++) {
+                print_log_entry(&chunk_logs[j]);
+            }
+            retry_queue_settle(retries, chunk->results);
+            retry_in_flight = 0;
+        } else {
+            for (int j = 0; j < chunk->count; j++) {
+                print_log_entry(&chunk_logs[j]);
+                if (chunk->results[j] != SUCCESS) {
+                    add_failed(failed, chunk->base_id + j, &chunk->txns[j], chunk->legs);
+                    if (retries != NULL) {
+                        retry_queue_park(retries, chunk->base_id + j, &chunk->txns[j], chunk->legs, now_ns());
+                    }
+                }
+            }
+        }
+        retired++;
+
+        // -r: emekliye ayrılan parçaların alacakları bekleyen işlemleri karşıladıysa onlar
+        // boşalan yerde hemen tekrar denenir (son, yarım parçadan sonra değil: kalanlar
+        // çalışmadan sonraki turlarda denenir)
+        if (retries != NULL && !retry_in_flight && !end_of_file && published - retired < CHUNK_SLOTS) {
+            Chunk *next = &queue->chunks[published % CHUNK_SLOTS];
+            int count = retry_queue_take(retries, next->txns, next->ids, next->legs, CHUNK_SIZE, 0);
+            if (count > 0) {
+                collected[published % CHUNK_SLOTS] = 0;
+                next->base_id = 0;
+                next->retry = 1;
+                next->aggregated = 0;
+                publish_chunk(queue, next, count);
+                published++;
+                retry_in_flight = 1;
+            }
+        }
+    }
+
+    if (wait_worker_pool(queue, started) == -1) {
+        exit(EXIT_FAILURE);
+    }
+    if (gate != NULL) {
+        // Sonraki yazanlar (tekrar denemeler) son epoch ile yazar
+        table->write_epoch = gate->epoch;
+        snapshot_gate_destroy(gate);
+    }
+    if (queue->shards != NULL) {
+        shard_set_destroy(queue->shards);
+    }
+
+    free(ordered);
+    reader_close(&reader);
+    shared_free(queue);
+    return num_transactions;
+}
+
+// -m serial: worker yok, ana process dosyayı parça parça okuyup sırayla çalıştırır
+// Kilit ve process arası iletişim olmadığı için paralel modların karşılaştırma noktasıdır
+// Parametreler ve dönüş değeri run_pool ile aynıdır
+static int run_serial(const Config *config, AccountTable *table, LockSet *locks, LogRing **logs_out,
+                      FailedList *failed, Snapshotter *snapshots, Auditor *audits,
+                      LatencyStats *stats, DepositAggregator *deposits) {
+    TransactionReader reader;
+    if (reader_open(&reader, config->transactions_file) == -1) {
+        return -1;
+    }
+
+    // Her işlemin kaydı hemen okunduğu için halkada tek parçalık yer yeterlidir
+    LogRing *logs = log_ring_create(CHUNK_SIZE);
+    if (logs == NULL) {
+        exit(EXIT_FAILURE);
+    }
+    *logs_out = logs;
+
+    Transaction *batch = (Transaction *)malloc(CHUNK_SIZE * sizeof(Transaction));
+    Leg *legs = (Leg *)malloc(CHUNK_LEGS * sizeof(Leg));
+    int *deposit_total = (int *)malloc(CHUNK_SIZE * sizeof(int));
+    reader.legs = legs;
+    LatencyHistogram *histogram = stats != NULL ? &stats->slots[0] : NULL;
+    int num_transactions = 0;
+    int count;
+    do {
+        count = reader_next_batch(&reader, batch, CHUNK_SIZE);
+        if (deposits != NULL) {
+            aggregate_deposits(deposits, batch, legs, count, deposit_total);
+        }
+        // Tek process: snapshot ve denetim için epoch kapısına gerek yok
+        if (snapshots != NULL && snapshots->interval_ms > 0 && snapshot_due(snapshots)) {
+            snapshot_take(snapshots, NULL);
+        }
+        if (audits != NULL && audit_due(audits)) {
+            audit_take(audits, NULL);
+        }
+        for (int j = 0; j < count; j++) {
+            long start = histogram != NULL ? now_ns() : 0;
+            int result;
+            if (deposits != NULL && deposit_total[j] != DEPOSIT_UNMERGED) {
+                result = process_deposit_run(table, logs, batch[j].to_account, batch[j].amount,
+                                             deposit_total[j], num_transactions, locks);
+            } else {
+                result = execute_transaction(table, logs, &batch[j], legs, num_transactions, locks);
+            }
+            if (histogram != NULL) {
+                latency_record(histogram, now_ns() - start);
+            }
+
+            if (num_transactions == 0 && !quiet) {
+                printf("\nTransaction Log:\n");
+            }
+            print_next_log(logs);
+            if (result != SUCCESS) {
+                add_failed(failed, num_transactions, &batch[j], legs);
+            }
+            num_transactions++;
+        }
+    } while (count == CHUNK_SIZE);
+
+    free(deposit_total);
+    free(legs);
+    free(batch);
+    reader_close(&reader);
+    return num_transactions;
+}
+
+// -D: daemon modu; hesaplar bellekte kalır, her bağlantı için fork edilen bir process
+// istemcinin gönderdiği işlemleri çalıştırır. Durma sinyali gelince yeni bağlantı kabul
+// edilmez, açık bağlantıların process'leri durdurulup beklenir.
+// journal: NULL değilse (-j) cevaplar işlemler journal'da kalıcı olduktan sonra gönderilir
+// stats: NULL değilse bağlantı process'leri işlem sürelerini ilk histograma yazar
+// Dönüş: Çalıştırılan işlem sayısı (socket açılamazsa -1)
+static int run_daemon(const Config *config, AccountTable *table, LockSet *locks, Journal *journal,
+                      LatencyStats *stats) {
+    int listen_fd = server_listen(config->daemon_socket);
+    if (listen_fd == -1) {
+        return -1;
+    }
+    ServerState *state = server_state_create();
+    if (state == NULL) {
+        exit(EXIT_FAILURE);
+    }
+    printf("Daemon listening on %s (%d accounts)\n", config->daemon_socket, table->num_accounts);
+
+    pid_t *children = NULL;  // Açık bağlantıların process'leri
+    int num_children = 0;
+    int capacity = 0;
+    long connections = 0;
+    while (!server_stopping()) {
+        int fd = accept(listen_fd, NULL, NULL);
+
+        // Biten bağlantıları topla (journal yazıcısı da child olduğu için pid ile beklenir)
+        for (int c = 0; c < num_children; c++) {
+            if (waitpid(children[c], NULL, WNOHANG) > 0) {
+                children[c--] = children[--num_children];
+            }
+        }
+        if (fd == -1) {
+            if (errno == EINTR) {
+                continue;  // Durma sinyali
+            }
+            perror("accept failed");
+            break;
+        }
+
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == -1) {
+            perror("fork failed for connection");
+            close(fd);
+            continue;
+        } else if (pid == 0) {  // Bağlantı process'i
+            close(listen_fd);
+            LatencyHistogram *histogram = NULL;
+            if (stats != NULL) {
+                histogram = &stats->slots[0];
+                locks->wait_ns = &histogram->lock_wait_ns;
+            }
+            long served = server_serve(fd, table, locks, state, journal, histogram);
+            close(fd);
+            _exit(served == -1 ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        close(fd);
+        if (num_children == capacity) {
+            capacity = capacity == 0 ? 16 : capacity * 2;
+            children = (pid_t *)realloc(children, capacity * sizeof(pid_t));
+        }
+        children[num_children++] = pid;
+        connections++;
+    }
+
+    // Yeni bağlantı kabul etme, açık bağlantılar elindeki istekleri bitirip çıksın
+    close(listen_fd);
+    unlink(config->daemon_socket);
+    for (int c = 0; c < num_children; c++) {
+        kill(children[c], SIGTERM);
+    }
+    for (int c = 0; c < num_children; c++) {
+        waitpid(children[c], NULL, 0);
+    }
+    free(children);
+
+    long transactions = __atomic_load_n(&state->next_id, __ATOMIC_ACQUIRE);
+    printf("\nDaemon: %ld transactions (%ld failed) over %ld connections\n",
+           transactions, state->failed, connections);
+    shmdt(state);
+    return (int)transactions;
+}
+
+// Log kayıtlarını işlem ID'sine göre sıralamak için (qsort)
+static int compare_log_id(const void *a, const void *b) {
+    const TransactionLog *x = (const TransactionLog *)a;
+    const TransactionLog *y = (const TransactionLog *)b;
+    return (x->transaction_id > y->transaction_id) - (x->transaction_id < y->transaction_id);
+}
+
+// Tekrar deneme turunun count log kaydını halkadan alıp ID sırasıyla yazar
+static void print_round_logs(LogRing *logs, int count) {
+    TransactionLog *entries = (TransactionLog *)malloc(count * sizeof(TransactionLog));
+    for (int k = 0; k < count; k++) {
+        while (!log_ring_pop(logs, &entries[k])) {
+            sched_yield();  // Kayıt yazılmak üzere
+        }
+    }
+    qsort(entries, count, sizeof(TransactionLog), compare_log_id);
+    for (int k = 0; k < count; k++) {
+        print_log_entry(&entries[k]);
+    }
+    free(entries);
+}
+
+// Tekrar deneme turunun çok ayaklı işlemlerinin legs içinde kapladığı yer
+static int round_legs(const Transaction *txns, int count) {
+    int num_legs = 0;
+    for (int k = 0; k < count; k++) {
+        if (txns[k].type == MULTI_LEG) {
+            num_legs += (int)txns[k].to_account;
+        }
+    }
+    return num_legs;
+}
+
+// -r, -m fork: turdaki her işlem için aynı anda bir child process, sonra hepsi beklenir
+// legs: Turun çok ayaklı işlemlerinin ayakları (retry_queue_take)
+static void retry_round_forked(AccountTable *table, LockSet *locks, LogRing *logs,
+                               const Transaction *txns, const Leg *legs, const int *ids, int count,
+                               int *results) {
+    pid_t *pids = (pid_t *)malloc(count * sizeof(pid_t));
+    fflush(stdout);
+    for (int k = 0; k < count; k++) {
+        pids[k] = fork();
+        if (pids[k] == -1) {
+            perror("fork failed");
+            exit(EXIT_FAILURE);
+        } else if (pids[k] == 0) {
+            exit(execute_transaction(table, logs, &txns[k], legs, ids[k], locks));
+        }
+    }
+    for (int k = 0; k < count; k++) {
+        int status;
+        waitpid(pids[k], &status, 0);
+        results[k] = WIFEXITED(status) && WEXITSTATUS(status) == SUCCESS ? SUCCESS : FAILURE;
+    }
+    free(pids);
+}
+
+// -r, pool modları: tur tek bir tekrar deneme parçası olarak yeni bir worker pool'a verilir
+// waves: NULL değilse (kilitsiz modlar) parça ortak hesabı olmayan dalgalara bölünür
+static void retry_round_pool(const Config *config, AccountTable *table, LockSet *locks, LogRing *logs,
+                             Scheduler *waves, const Transaction *txns, const Leg *legs, const int *ids,
+                             int count, int *results) {
+    WorkQueue *queue = (WorkQueue *)shared_alloc(sizeof(WorkQueue), "retry queue");
+    if (queue == NULL) {
+        exit(EXIT_FAILURE);
+    }
+    work_queue_init(queue);
+    queue->engine = config->engine;
+
+    Chunk *chunk = &queue->chunks[0];
+    chunk->base_id = 0;
+    chunk->retry = 1;
+    memcpy(chunk->txns, txns, count * sizeof(Transaction));
+    memcpy(chunk->ids, ids, count * sizeof(int));
+    memcpy(chunk->legs, legs, round_legs(txns, count) * sizeof(Leg));
+    if (waves != NULL) {
+        queue->schedule = SCHEDULE_WAVES;
+        schedule_chunk(waves, chunk, count);
+    }
+
+    int num_workers = config->num_workers < count ? config->num_workers : count;
+    int started = start_worker_pool(queue, num_workers, table, logs, locks);
+    if (started == 0) {
+        exit(EXIT_FAILURE);
+    }
+    publish_chunk(queue, chunk, count);
+    finish_work_queue(queue);
+    wait_chunk(chunk);
+    if (wait_worker_pool(queue, started) == -1) {
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(results, chunk->results, count * sizeof(int));
+    shared_free(queue);
+}
+
+// -r: başarısız işlemleri ertelenmiş tekrar deneme kuyruğuna koyar
+// (-m pool dışındaki modlarda çalışmadan sonra; -m pool'da run_pool koyar)
+static void park_failed(RetryQueue *retries, const FailedList *failed) {
+    for (int j = 0; j < failed->count; j++) {
+        const FailedTransaction *item = &failed->items[j];
+        retry_queue_park(retries, item->transaction_id, &item->txn, item->legs, item->failed_ns);
+    }
+}
+
+// -r: kuyrukta kalan işlemlerden bakiyesi yetenleri turlar halinde, hiçbirinin bakiyesi
+// yetmeyene kadar tekrar dener
+static void retry_deferred(const Config *config, AccountTable *table, LockSet *locks, LogRing *logs,
+                           RetryQueue *retries) {
+    if (retries->count == 0) {
+        return;
+    }
+    if (!quiet) {
+        printf("\nRetrying %d failed transactions (deferred, at most %d attempts)...\n",
+               retries->count, retries->max_attempts);
+    }
+
+    // Kilitsiz modlarda (sched / ordered / shard) tur, ortak hesabı olmayan dalgalarla çalışır
+    Scheduler waves_state;
+    Scheduler *waves = NULL;
+    if (locks->backend == LOCK_NONE && config->mode != MODE_SERIAL) {
+        scheduler_init(&waves_state, SCHEDULE_WAVES, table);
+        waves = &waves_state;
+    }
+
+    Transaction *txns = (Transaction *)malloc(CHUNK_SIZE * sizeof(Transaction));
+    Leg *legs = (Leg *)malloc(CHUNK_LEGS * sizeof(Leg));
+    int ids[CHUNK_SIZE];
+    int results[CHUNK_SIZE];
+    int count;
+    while ((count = retry_queue_take(retries, txns, ids, legs, CHUNK_SIZE, 1)) > 0) {
+        if (!quiet) {
+            printf("Retry round %ld: %d transactions\n", retries->rounds, count);
+        }
+        if (config->mode == MODE_FORK) {
+            retry_round_forked(table, locks, logs, txns, legs, ids, count, results);
+        } else if (config->mode == MODE_SERIAL) {
+            for (int k = 0; k < count; k++) {
+                results[k] = execute_transaction(table, logs, &txns[k], legs, ids[k], locks);
+            }
+        } else {
+            retry_round_pool(config, table, locks, logs, waves, txns, legs, ids, count, results);
+        }
+        print_round_logs(logs, count);
+        retry_queue_settle(retries, results);
+    }
+
+    free(txns);
+    free(legs);
+    if (waves != NULL) {
+        scheduler_destroy(waves);
+    }
+}
+
+// Hesap alanini yaratir ve baglar
+// Process engine: ftok anahtarli shared memory (onceki calistirmadan kalan kucuk segment
+// silinip yeniden yaratilir); -e threads: process'e ozel bellek, *shm_id -1 kalir
+static Account *attach_accounts(key_t shm_key, size_t size, WorkerEngine engine, int *shm_id) {
+    if (engine == ENGINE_THREADS) {
+        Account *accounts = (Account *)shared_alloc(size, "accounts");
+        if (accounts == NULL) {
+            exit(EXIT_FAILURE);
+        }
+        return accounts;
+    }
+
+    int accounts_shm_id = shmget(shm_key, size, IPC_CREAT | 0666);
+    if (accounts_shm_id == -1 && errno == EINVAL) {
+        // Onceki calistirmadan kalan segment bu hesap sayisi icin kucuk: silip yeniden yarat
+        int stale_id = shmget(shm_key, 0, 0);
+        if (stale_id != -1) {
+            shmctl(stale_id, IPC_RMID, NULL);
+        }
+        accounts_shm_id = shmget(shm_key, size, IPC_CREAT | 0666);
+    }
     if (accounts_shm_id == -1) {
         perror("shmget failed for accounts");
         exit(EXIT_FAILURE);
@@ -26,219 +836,409 @@ int main() {
         perror("shmat failed for accounts");
         exit(EXIT_FAILURE);
     }
-    // shmget ortak bellek oluşturur
-    // shmat ortak belleği bağlar
-    // shmdt ortak belleği ayırır
-    // shmctl bellek silme işlemleri için kullanılır
-    
-    // Transaction log'lar icin shared memory yarat
-    int logs_shm_id = shmget(shm_key + 1, MAX_TRANSACTIONS * sizeof(TransactionLog), IPC_CREAT | 0666);
-    if (logs_shm_id == -1) {
-        perror("shmget failed for transaction logs");
-        exit(EXIT_FAILURE);
+    *shm_id = accounts_shm_id;
+    return accounts;
+}
+
+// attach_accounts ile alinan hesap alanini birakir (shared memory ise tamamen siler)
+static void release_accounts(Account *accounts, int shm_id) {
+    if (shm_id == -1) {
+        shared_free(accounts);
+        return;
     }
+    shmdt(accounts);
+    shmctl(shm_id, IPC_RMID, NULL);
+}
 
-    // Shared memory'ye baglan (loglar)
-    TransactionLog *logs = (TransactionLog *)shmat(logs_shm_id, NULL, 0);
-    if (logs == (void *)-1) {
-        perror("shmat failed for transaction logs");
+int main(int argc, char *argv[]) {
+    // Komut satırı ayarlarını oku (-m fork|pool|sched|ordered|serial|shard, -w worker sayısı, -l sem|futex, -c)
+    Config config;
+    if (parse_config(argc, argv, &config) == -1) {
         exit(EXIT_FAILURE);
     }
+    quiet = config.quiet;
+    // -e threads: worker'larin paylastigi bellek process'e ozel olur (IPC nesnesi yok)
+    set_private_memory(config.engine == ENGINE_THREADS);
+    int daemon_mode = config.daemon_socket != NULL;
+
+    // -D: Ctrl-C / SIGTERM daemon'u sırayla kapatır; handler fork edilen tüm process'lere geçer
+    if (daemon_mode) {
+        server_install_signals();
+    }
+
+    // IPC key'i olusturuluyor
+    // ftok benzersiz anahtar oluşturur (farklı programlar arasında çakışmaması için )
+    key_t shm_key = ftok(".", 'S');   // Shared memory key
+
+    // -S: snapshot varsa hesaplar oradan gelir (mmap ile kopyalanir, parse yok)
+    Account *loaded = NULL;
+    int num_accounts = BINARY_NOT_BINARY;
+    long snapshot_journal_records = 0;  // Snapshot'a dahil olan journal kayitlari
+    if (config.snapshot_file != NULL) {
+        num_accounts = snapshot_load(config.snapshot_file, &loaded, &snapshot_journal_records);
+        if (num_accounts == -1) {
+            exit(EXIT_FAILURE);  // Snapshot bozuk: sessizce eski bakiyelerle baslama
+        }
+        if (num_accounts != BINARY_NOT_BINARY) {
+            printf("Loaded %d accounts from snapshot %s\n", num_accounts, config.snapshot_file);
+        }
+    }
 
     // Hesaplari dosyadan oku veya varsayilan degerlerle baslat
     // hesap bilgilerini accounts.txt dosyasından okumaya çalışır 
     // eğer dosya yoksa veya boşsa varsayılan hesapları oluşturur
-    int num_accounts = initialize_accounts(ACCOUNTS_FILE, accounts, MAX_ACCOUNTS);
+    if (num_accounts == BINARY_NOT_BINARY) {
+        num_accounts = load_accounts(config.accounts_file, &loaded);
+    }
     if (num_accounts <= 0) {
         printf("Creating default accounts since no file was found or file was empty\n");
         num_accounts = 5;
+        free(loaded);
+        loaded = (Account *)calloc(num_accounts, sizeof(Account));
         for (int i = 0; i < num_accounts; i++) {
-            accounts[i].account_id = i;
-            accounts[i].balance = 500;  // Varsayilan bakiye
+            loaded[i].account_id = i;
+            loaded[i].balance = 500;  // Varsayilan bakiye
         }
     }
 
-    // Her hesap icin semaphore seti olustur
-    int sem_id = semget(sem_key, num_accounts, IPC_CREAT | 0666);
-    if (sem_id == -1) {
-        perror("semget failed");
+    // Hesaplar icin shared memory yarat (boyut hesap sayisina gore)
+    // Futex kilitleri, ID indeksi, (LAYOUT=padded) bakiye satirlari ve epoch basi bakiyeleri
+    // ayni segmentte, hesap dizisinin arkasinda cache line hizali durur
+    size_t locks_offset = ((size_t)num_accounts * sizeof(Account) + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    size_t index_offset = (locks_offset + lock_area_size(num_accounts) + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    size_t lines_offset = (index_offset + account_index_size(num_accounts) + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    size_t versions_offset = (lines_offset + account_lines_size(num_accounts) + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    size_t accounts_shm_size = versions_offset + account_versions_size(num_accounts);
+    int accounts_shm_id = -1;
+    Account *accounts = attach_accounts(shm_key, accounts_shm_size, config.engine, &accounts_shm_id);
+
+    // -p / -N: worker'larin CPU'lari ve node'lari; hesap alani sayfalara dokunulmadan yerlestirilir
+    // (bakiyeler, kilitler ve surumler worker'larin slot araliklarina gore, indeks dagitilarak)
+    Placement placement_state;
+    Placement *placement = NULL;
+    if (config.pin_workers && !daemon_mode && !config.recover && config.mode != MODE_FORK &&
+        config.mode != MODE_SERIAL) {
+        if (placement_init(&placement_state, config.memory_placement, config.num_workers) == -1) {
+            release_accounts(accounts, accounts_shm_id);
+            exit(EXIT_FAILURE);
+        }
+        placement = &placement_state;
+        char *area = (char *)accounts;
+        size_t lock_words = lock_area_size(num_accounts) - lock_area_size(0);
+        placement_place_slots(placement, area, (size_t)num_accounts * sizeof(Account), num_accounts);
+        placement_place_slots(placement, area + locks_offset + lock_area_size(0), lock_words, num_accounts);
+        placement_interleave(placement, area + index_offset, account_index_size(num_accounts));
+        placement_place_slots(placement, area + lines_offset, account_lines_size(num_accounts), num_accounts);
+        placement_place_slots(placement, area + versions_offset, account_versions_size(num_accounts),
+                              num_accounts);
+    }
+    // shmget ortak bellek oluşturur
+    // shmat ortak belleği bağlar
+    // shmdt ortak belleği ayırır
+    // shmctl bellek silme işlemleri için kullanılır
+
+    // Hesaplari ortak bellege kopyala ve ID -> slot indeksini kur
+    memcpy(accounts, loaded, (size_t)num_accounts * sizeof(Account));
+    free(loaded);
+    AccountTable table;
+    if (account_table_init(&table, accounts, num_accounts, (char *)accounts + index_offset,
+                           (char *)accounts + lines_offset, (char *)accounts + versions_offset) == -1) {
+        release_accounts(accounts, accounts_shm_id);
         exit(EXIT_FAILURE);
     }
 
-    // Her semaphore'u 1 olarak baslat
-    for (int i = 0; i < num_accounts; i++) {
-        if (init_semaphore(sem_id, i, 1) == -1) {
-            perror("Failed to initialize semaphore");
+    // Kurtarma modu: islem calistirmadan hesap dosyasi (veya snapshot) + journal'dan bakiyeleri kur
+    // Snapshot'a zaten dahil olan journal kayitlari atlanir
+    if (config.recover) {
+        long replayed = journal_replay(config.journal_file, &table, snapshot_journal_records);
+        if (replayed == -1) {
             exit(EXIT_FAILURE);
         }
-    }
+        printf("Recovered %ld transactions from journal %s\n", replayed, config.journal_file);
+        print_final_balances(&table);
 
-    // Transaction dosyasini oku
-    int *t_type = NULL, *from_acc = NULL, *to_acc = NULL, *amount = NULL;
-    int num_transactions = read_transactions(TRANSACTIONS_FILE, &t_type, &from_acc, &to_acc, &amount);
+        release_accounts(accounts, accounts_shm_id);
+        return 0;
+    }
 
-    if (num_transactions <= 0) {
-        printf("No transactions found in file. Exiting.\n");
+    // Hesap kilitlerini hazirla (-l sem: semaphore setleri, -l futex: shared memory'deki futex kelimeleri)
+    LockSet lock_set;
+    // -m sched / ordered / serial: ayni anda calisan islemlerin ortak hesabi olmadigi icin kilit gerekmez
+    // -m shard: her hesaba sadece sahibi olan worker dokunur
+    // -D: bağlantı process'leri her zaman hesap kilitleriyle çalışır
+    int lock_free_mode = !daemon_mode && (config.mode == MODE_SCHED || config.mode == MODE_ORDERED ||
+                                          config.mode == MODE_SERIAL || config.mode == MODE_SHARD);
+    LockBackend backend = lock_free_mode ? LOCK_NONE : config.lock_backend;
+    if (init_lock_set(&lock_set, backend, (char *)accounts + locks_offset, &table) == -1) {
+        exit(EXIT_FAILURE);
+    }
+    lock_set.lock_free_single = config.lock_free_single;  // -c: yatırma / çekme kilitsiz
+#ifdef BANK_STATS
+    // STATS=1: hesap basina cekisme sayaclari (worker'lar ve child'lar ortak bellege yazar)
+    lock_set.stats = account_stats_create(num_accounts);
+    if (lock_set.stats == NULL) {
         exit(EXIT_FAILURE);
     }
+#endif
+    LockSet *locks = &lock_set;
 
-    // Başarısız işlemleri takip etmek için değişkenler
-    int failed_transactions[MAX_TRANSACTIONS]; // başarısız işlemlerin numaralarını saklamak için
-    int num_failed = 0; // başarısız işlem sayısı
-    pid_t transaction_pids[MAX_TRANSACTIONS]; // Tüm işlemlerin PID'leri
-    int transaction_results[MAX_TRANSACTIONS]; // İşlemlerin sonuçları
-    int completed_transactions = 0; // Tamamlanan işlem sayısı
+    // -j: uygulanan islemler ayri bir yazici process tarafindan gruplar halinde diske yazilir
+    Journal journal;
+    int journal_enabled = config.journal_file != NULL;
+    if (journal_enabled) {
+        if (journal_open(&journal, config.journal_file, config.journal_group, config.journal_window_ms) == -1) {
+            exit(EXIT_FAILURE);
+        }
+        set_transaction_journal(&journal);
+    }
 
-    // Her transaction için child process yarat
-    for (int i = 0; i < num_transactions; i++) {
-        pid_t pid = fork();
+    // -S: calisma sirasinda periyodik, sonda bir kez snapshot
+    Snapshotter snapshotter;
+    Snapshotter *snapshots = NULL;
+    if (config.snapshot_file != NULL) {
+        snapshotter_init(&snapshotter, config.snapshot_file, config.snapshot_interval_ms,
+                         &table, journal_enabled ? &journal : NULL);
+        snapshots = &snapshotter;
+        // Journal bu calismayla sifirdan basladi: kurtarma icin baslangic durumu da snapshot'ta olmali
+        if (journal_enabled && snapshot_take(snapshots, NULL) == -1) {
+            exit(EXIT_FAILURE);
+        }
+    }
 
-        if (pid == -1) {
-            perror("fork failed");
+    // -A: calisma sirasinda periyodik tutarli bakiye toplami (fork ve shard modlarinda tutarli an yok)
+    Auditor auditor;
+    Auditor *audits = NULL;
+    if (config.audit_interval_ms > 0 && !daemon_mode && config.mode != MODE_FORK &&
+        config.mode != MODE_SHARD) {
+        auditor_init(&auditor, config.audit_interval_ms, &table);
+        audits = &auditor;
+    }
+
+    // -b: islem sureleri worker (fork ve serial modunda tek) histogramlarina yazilir
+    LatencyStats *stats = NULL;
+    if (config.bench) {
+        int single = config.mode == MODE_FORK || config.mode == MODE_SERIAL || daemon_mode;
+        stats = latency_stats_create(single ? 1 : config.num_workers);
+        if (stats == NULL) {
             exit(EXIT_FAILURE);
-        } 
-        else if (pid == 0) {  // Child process
-            int result;
-            switch (t_type[i]) {
-                case DEPOSIT:
-                    result = process_deposit(accounts, logs, to_acc[i], amount[i], i, sem_id);
-                    break;
-                case WITHDRAW:
-                    result = process_withdraw(accounts, logs, from_acc[i], amount[i], i, sem_id);
-                    break;
-                case TRANSFER:
-                    result = process_transfer(accounts, logs, from_acc[i], to_acc[i], amount[i], i, sem_id);
-                    break;
-            }
-            exit(result);  // Çıkış kodu: 0 (başarı) veya -1 (hata)
         }
-        else {
-            transaction_pids[i] = pid; // PID'yi sakla
+    }
+
+    // -m sched: parcalar ortak hesabi olmayan dalgalara bolunur
+    // -m ordered: her islem dokundugu hesaplarda sira numarasi alir
+    Scheduler scheduler_state;
+    Scheduler *scheduler = NULL;
+    if (!daemon_mode && (config.mode == MODE_SCHED || config.mode == MODE_ORDERED)) {
+        ScheduleKind kind = config.mode == MODE_SCHED ? SCHEDULE_WAVES : SCHEDULE_TURNS;
+        if (scheduler_init(&scheduler_state, kind, &table) == -1) {
+            exit(EXIT_FAILURE);
         }
+        scheduler = &scheduler_state;
     }
 
-    // İşlemleri bekle ve başarısız olanları kaydet
-    while (completed_transactions < num_transactions) {
-        int status;
-        pid_t finished_pid = wait(&status);
-        
-        // Hangi işlem tamamlandı?
-        for (int i = 0; i < num_transactions; i++) {
-            if (transaction_pids[i] == finished_pid) {
-                // İşlem sonucunu kaydet
-                if (WIFEXITED(status)) {
-                    transaction_results[i] = WEXITSTATUS(status);
-                    
-                    // Başarısız işlemleri kaydet
-                    if (transaction_results[i] != SUCCESS) {
-                        failed_transactions[num_failed++] = i;
-                        printf("Debug: Transaction %d failed with exit code %d\n", i, transaction_results[i]);  // Hata ayıklama çıktısı
+    // -d: ayni hesaba ardisik yatirmalar parca icinde tek bakiye guncellemesine toplanir
+    DepositAggregator deposits_state;
+    DepositAggregator *deposits = NULL;
+    if (config.aggregate_deposits && !daemon_mode && config.mode != MODE_FORK) {
+        deposit_aggregator_init(&deposits_state, &table);
+        deposits = &deposits_state;
+    }
 
-                    }
-                }
-                completed_transactions++;
-                break;
-            }
+    // -r: ertelenmis tekrar deneme kuyrugu; -m pool'da worker'lar calisirken de tekrar dener
+    // (diger modlarda islem ID'leri parca sirasiyla gider, kuyruk calismadan sonra dolar)
+    RetryQueue retries;
+    RetryQueue *inline_retries = NULL;
+    if (config.retry_attempts > 0) {
+        retry_queue_init(&retries, &table, config.retry_attempts, config.retry_backoff_ms);
+        if (config.mode == MODE_POOL) {
+            inline_retries = &retries;
         }
     }
 
-    // Transaction log yazdır (ilk çalıştırma)
-    printf("\nTransaction Log:\n");
-    for (int i = 0; i < num_transactions; i++) {
-        if (strcmp(logs[i].type, "Deposit") == 0) {
-            printf("Transaction %d: %s %d to Account %d (%s)\n", 
-                   logs[i].transaction_id, logs[i].type, 
-                   logs[i].amount, logs[i].to_account, logs[i].status);
-        } else if (strcmp(logs[i].type, "Withdraw") == 0) {
-            printf("Transaction %d: %s %d from Account %d (%s)\n", 
-                   logs[i].transaction_id, logs[i].type, 
-                   logs[i].amount, logs[i].from_account, logs[i].status);
-        } else if (strcmp(logs[i].type, "Transfer") == 0) {
-            printf("Transaction %d: %s %d from Account %d to Account %d (%s)\n", 
-                   logs[i].transaction_id, logs[i].type, 
-                   logs[i].amount, logs[i].from_account, 
-                   logs[i].to_account, logs[i].status);
-        }
-    }
-
-   // Başarısız işlemleri tekrar dene
-if (num_failed > 0) {
-    printf("\nRetrying %d failed transactions...\n", num_failed);
-}
-
-for (int j = 0; j < num_failed; j++) {
-    int i = failed_transactions[j];
-    
-    printf("Transaction %d failed. Retrying once...\n", i);
-    
-    pid_t pid = fork();
-    if (pid == -1) {
-        perror("fork failed");
+    // İşlemleri çalıştır, başarısız olanları topla
+    FailedList failed = { NULL, 0, 0 };
+    LogRing *logs = NULL;
+    int num_transactions;
+    long run_start = now_ns();
+    if (daemon_mode) {
+        num_transactions = run_daemon(&config, &table, locks, journal_enabled ? &journal : NULL, stats);
+    } else if (config.mode == MODE_FORK) {
+        num_transactions = run_forked(config.transactions_file, &table, locks, &logs, &failed, stats);
+    } else if (config.mode == MODE_SERIAL) {
+        num_transactions = run_serial(&config, &table, locks, &logs, &failed, snapshots, audits, stats,
+                                      deposits);
+    } else {
+        num_transactions = run_pool(&config, &table, locks, &logs, &failed, snapshots, audits, stats,
+                                    scheduler, deposits, placement, inline_retries);
+    }
+    long run_ns = now_ns() - run_start;  // Calismadan sonraki tekrar denemeler dahil degil
+
+    // Daemon hiç işlem almadan da düzgün kapanır
+    if (num_transactions < 0 || (num_transactions == 0 && !daemon_mode)) {
+        if (num_transactions == 0 && !daemon_mode) {
+            printf("No transactions found in file. Exiting.\n");
+        }
+        if (journal_enabled) {
+            journal_close(&journal);  // Yazıcı process'i de sonlandır
+        }
+        // Semaphore setleri IPC_PRIVATE oldugu icin silinmezse sistemde kalir
+        destroy_lock_set(locks);
+        release_accounts(accounts, accounts_shm_id);
         exit(EXIT_FAILURE);
-    } else if (pid == 0) {
-        int result;
-        switch (t_type[i]) {
-            case DEPOSIT:
-                result = process_deposit(accounts, logs, to_acc[i], amount[i], i, sem_id);
-                break;
-            case WITHDRAW:
-                result = process_withdraw(accounts, logs, from_acc[i], amount[i], i, sem_id);
-                break;
-            case TRANSFER:
-                result = process_transfer(accounts, logs, from_acc[i], to_acc[i], amount[i], i, sem_id);
-                break;
+    }
+
+    // Başarısız işlemleri tekrar dene
+    // -r: bakiyesi yetene kadar bekleten ertelenmiş kuyruk; yoksa her biri sonda bir kez, hemen
+    if (config.retry_attempts > 0) {
+        if (inline_retries == NULL) {
+            park_failed(&retries, &failed);
+        }
+        retry_deferred(&config, &table, locks, logs, &retries);
+    } else {
+        if (failed.count > 0 && !quiet) {
+            printf("\nRetrying %d failed transactions...\n", failed.count);
+        }
+
+        for (int j = 0; j < failed.count; j++) {
+            FailedTransaction *item = &failed.items[j];
+
+            if (!quiet) {
+                printf("Transaction %d failed. Retrying once...\n", item->transaction_id);
+            }
+
+            int retry_result;
+            if (config.mode == MODE_FORK) {
+                retry_result = retry_forked(item, &table, logs, locks);
+            } else {
+                // Pool modunda worker'lar bitti; tekrar denemeyi ana process doğrudan yapar
+                retry_result = execute_transaction(&table, logs, &item->txn, item->legs, item->transaction_id, locks);
+            }
+            if (!quiet) {
+                printf("Retry result for transaction %d: %s\n",
+                       item->transaction_id, retry_result == SUCCESS ? "Success" : "Failed again");
+            }
+
+            // Yeniden denenen işlemin logunu yazdır (halkada okunmamış tek kayıt)
+            print_next_log(logs);
         }
-        exit(result);
     }
-    
-    // Yeniden denenen işlemin tamamlanmasını bekle
-    int status;
-    wait(&status);
-    
-    // Yeniden denenen işlemin sonucu
-    int retry_result = FAILURE;
-    if (WIFEXITED(status)) {
-        retry_result = WEXITSTATUS(status);
+
+    // Son durumun snapshot'i (journal konumu halka kapanmadan okunur)
+    int exit_code = 0;
+    if (snapshots != NULL && snapshot_take(snapshots, NULL) == -1) {
+        exit_code = EXIT_FAILURE;
     }
-    printf("Retry result for transaction %d: %s\n", 
-           i, retry_result == SUCCESS ? "Success" : "Failed again");
-    
-    // Yeniden denenen işlemin logunu yazdır
-    if (strcmp(logs[i].type, "Transfer") == 0) {
-        printf("Transaction %d: %s %d from Account %d to Account %d (%s)\n", 
-               logs[i].transaction_id, logs[i].type, 
-               logs[i].amount, logs[i].from_account, 
-               logs[i].to_account, logs[i].status);
-    } else if (strcmp(logs[i].type, "Deposit") == 0) {
-        printf("Transaction %d: %s %d to Account %d (%s)\n", 
-               logs[i].transaction_id, logs[i].type, 
-               logs[i].amount, logs[i].to_account, logs[i].status);
-    } else if (strcmp(logs[i].type, "Withdraw") == 0) {
-        printf("Transaction %d: %s %d from Account %d (%s)\n", 
-               logs[i].transaction_id, logs[i].type, 
-               logs[i].amount, logs[i].from_account, logs[i].status);
-    }
-}
-    // Final hesap bakiyeleri yazdir
-    printf("\nFinal account balances:\n");
-    for (int i = 0; i < num_accounts; i++) {
-        printf("Account %d: %d\n", accounts[i].account_id, accounts[i].balance);
+
+    // Journal'da bekleyen son grubu diske indir
+    if (journal_enabled && journal_close(&journal) == -1) {
+        fprintf(stderr, "Warning: journal %s is incomplete\n", config.journal_file);
+        exit_code = EXIT_FAILURE;
     }
 
-    // Bellek temizligi
-    free(t_type);
-    free(from_acc);
-    free(to_acc);
-    free(amount);
+    print_final_balances(&table);
 
-    // Shared memory baglantilarini kopar
-    shmdt(accounts);
-    shmdt(logs);
+    // Toplu semop() sayesinde kazanilan sistem cagrisi sayisi
+    if (locks->backend == LOCK_SEM) {
+        printf("\nSemaphore syscalls saved by batched semop(): %ld\n", locks->counters->semops_saved);
+    }
+
+    // Group commit: kac kayit icin kac fdatasync yapildi
+    if (journal_enabled) {
+        printf("\nJournal: %ld records written with %ld fdatasync calls\n", journal.records, journal.syncs);
+    }
+
+    // -r: kac basarisiz islem kurtarildi, kac deneme yapildi ve ne kadar surdu
+    if (config.retry_attempts > 0) {
+        printf("\nRetries: %d failed, %ld queued (%ld not retryable), %ld recovered (%.1f%%) in %ld attempts over %ld rounds; "
+               "%ld out of attempts, %d still short of funds\n",
+               failed.count, retries.parked, retries.not_retryable, retries.succeeded,
+               retries.parked > 0 ? 100.0 * retries.succeeded / retries.parked : 0.0,
+               retries.attempts, retries.rounds, retries.exhausted, retries.count);
+        if (retries.succeeded > 0) {
+            printf("Retry latency (us): p50 %.2f, p99 %.2f, max %.2f\n",
+                   latency_percentile(&retries.latency, 0.50) / 1e3,
+                   latency_percentile(&retries.latency, 0.99) / 1e3, retries.latency.max_ns / 1e3);
+        }
+        retry_queue_destroy(&retries);
+    }
+
+    // Dalga basina ortalama islem sayisi: zamanlayicinin buldugu paralellik
+    // (ordered: zincirin her adimina dusen islem sayisi, ulasilabilecek en yuksek paralellik)
+    if (scheduler != NULL && scheduler->kind == SCHEDULE_TURNS) {
+        printf("\nScheduler: %ld transactions, longest same-account chain %ld (%.1f transactions per step)\n",
+               scheduler->transactions, scheduler->longest_chain,
+               scheduler->longest_chain > 0 ? (double)scheduler->transactions / scheduler->longest_chain : 0.0);
+    } else if (scheduler != NULL) {
+        printf("\nScheduler: %ld transactions in %ld waves (%.1f transactions per wave)\n",
+               scheduler->transactions, scheduler->waves,
+               scheduler->waves > 0 ? (double)scheduler->transactions / scheduler->waves : 0.0);
+    }
+
+    // -d: kac yatirma kac bakiye guncellemesine toplandi
+    if (deposits != NULL) {
+        printf("\nDeposits: %ld pre-aggregated into %ld balance updates\n",
+               deposits->folded + deposits->runs, deposits->runs);
+    }
+
+    // Snapshot sayisi ve worker'larin epoch gecisinde en uzun bekledigi sure
+    if (snapshots != NULL) {
+        printf("\nSnapshots: %ld written to %s (longest worker pause: %ld us)\n",
+               snapshots->taken, config.snapshot_file, snapshots->max_pause_us);
+    }
+
+    // Denetim sayisi, gorulen toplamlar ve en uzun denetim suresi
+    if (audits != NULL) {
+        printf("\nAudits: %ld consistent totals (min %lld, max %lld, last %lld), longest audit %ld us, "
+               "longest worker pause %ld us\n",
+               audits->taken, (long long)audits->min_total, (long long)audits->max_total,
+               (long long)audits->last_total, audits->max_us, audits->max_pause_us);
+    }
+
+    // -p / -N: node basina worker'lar ve verim
+    if (placement != NULL) {
+        placement_report(placement, run_ns);
+    }
+
+#ifdef BANK_STATS
+    // En sicak hesaplar (bekleme suresine gore)
+    account_stats_report(lock_set.stats, accounts, num_accounts, config.top_k);
+    account_stats_destroy(lock_set.stats);
+#endif
+
+    // -b: verim, islem basina gecikme yuzdelikleri ve kilit bekleme suresi
+    if (stats != NULL) {
+        LatencyHistogram total;
+        latency_merge(stats, &total);
+        double seconds = run_ns / 1e9;
+        printf("\nBenchmark: %d transactions in %.3f s (%.0f transactions/s)\n",
+               num_transactions, seconds, seconds > 0 ? num_transactions / seconds : 0.0);
+        printf("Latency (us): p50 %.2f, p99 %.2f, p99.9 %.2f, max %.2f\n",
+               latency_percentile(&total, 0.50) / 1e3, latency_percentile(&total, 0.99) / 1e3,
+               latency_percentile(&total, 0.999) / 1e3, total.max_ns / 1e3);
+        printf("Lock wait: %.3f s (%.1f%% of transaction time)\n", total.lock_wait_ns / 1e9,
+               total.total_ns > 0 ? 100.0 * total.lock_wait_ns / total.total_ns : 0.0);
+        latency_stats_destroy(stats);
+    }
+
+    // Bellek temizligi
+    free_failed(&failed);
+    if (snapshots != NULL) {
+        snapshotter_destroy(snapshots);
+    }
+    if (scheduler != NULL) {
+        scheduler_destroy(scheduler);
+    }
+    if (deposits != NULL) {
+        deposit_aggregator_destroy(deposits);
+    }
+    if (placement != NULL) {
+        placement_destroy(placement);
+    }
 
-    // Shared memory ve semaphore'lari tamamen sil
-    shmctl(accounts_shm_id, IPC_RMID, NULL);
-    shmctl(logs_shm_id, IPC_RMID, NULL);
-    semctl(sem_id, 0, IPC_RMID);
+    // Shared memory baglantilarini kopar, shared memory ve semaphore'lari tamamen sil
+    log_ring_destroy(logs);
+    release_accounts(accounts, accounts_shm_id);
+    destroy_lock_set(locks);
 
-    return 0;
+    return exit_code;
 }
\ No newline at end of file
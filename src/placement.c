@@ -0,0 +1,248 @@
+#define _GNU_SOURCE                   // cpu_set_t, sched_getaffinity / sched_setaffinity
+#include "../include/placement.h"     // Placement
+#include "../include/utils.h"         // shared_alloc, syscall
+#include <linux/mempolicy.h>          // MPOL_INTERLEAVE, MPOL_PREFERRED, MPOL_MF_MOVE
+#include <stdint.h>                   // uintptr_t
+
+// mbind hatası bir kez yazılır; sonraki alanlar da büyük ihtimalle aynı sebeple başarısız olur
+static int mbind_warned = 0;
+
+// "0-3,8-11" biçimindeki CPU listesini kümeye ekler
+static void parse_cpu_list(const char *text, cpu_set_t *set) {
+    const char *p = text;
+    while (*p >= '0' && *p <= '9') {
+        char *end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+        if (*end == '-') {
+            last = strtol(end + 1, &end, 10);
+        }
+        for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET(cpu, set);
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+}
+
+// Node'un CPU'larını okur
+// Dönüş: 0 ise set dolduruldu, -1 ise böyle bir node yok
+static int read_node_cpus(int node, cpu_set_t *set) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+    char line[4096];
+    CPU_ZERO(set);
+    if (fgets(line, sizeof(line), file) != NULL) {
+        parse_cpu_list(line, set);
+    }
+    fclose(file);
+    return 0;
+}
+
+int placement_init(Placement *placement, MemoryPlacement memory, int num_workers) {
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == -1) {
+        perror("sched_getaffinity failed");
+        return -1;
+    }
+
+    placement->memory = memory;
+    placement->num_nodes = 0;
+    placement->num_cpus = 0;
+    placement->num_workers = num_workers;
+    placement->cpus = (int *)malloc(CPU_SETSIZE * sizeof(int));
+    placement->cpu_node = (int *)malloc(CPU_SETSIZE * sizeof(int));
+    placement->worker_cpu = (int *)malloc(num_workers * sizeof(int));
+    placement->worker_node = (int *)malloc(num_workers * sizeof(int));
+    placement->counters = NULL;
+    if (placement->cpus == NULL || placement->cpu_node == NULL || placement->worker_cpu == NULL ||
+        placement->worker_node == NULL) {
+        perror("malloc failed for placement");
+        placement_destroy(placement);
+        return -1;
+    }
+    int node_first[PLACEMENT_MAX_NODES];  // Node'un ilk CPU'sunun cpus içindeki yeri
+    int node_cpus[PLACEMENT_MAX_NODES];   // Node'un çalışılabilen CPU sayısı
+
+    // CPU'lar node sırasıyla; çalışılabilen CPU'su olmayan node'lar atlanır
+    for (int node = 0; node < PLACEMENT_MAX_NODES; node++) {
+        cpu_set_t set;
+        if (read_node_cpus(node, &set) == -1) {
+            continue;  // Node numaraları ardışık olmayabilir
+        }
+        int n = placement->num_nodes;
+        node_first[n] = placement->num_cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set) && CPU_ISSET(cpu, &allowed)) {
+                placement->cpus[placement->num_cpus] = cpu;
+                placement->cpu_node[placement->num_cpus] = n;
+                placement->num_cpus++;
+            }
+        }
+        node_cpus[n] = placement->num_cpus - node_first[n];
+        if (node_cpus[n] > 0) {
+            placement->node_ids[n] = node;
+            placement->num_nodes++;
+        }
+    }
+
+    // sysfs'te node yok (NUMA'sız kernel, container): tüm CPU'lar tek bir node 0'da
+    if (placement->num_nodes == 0) {
+        placement->num_cpus = 0;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                placement->cpus[placement->num_cpus] = cpu;
+                placement->cpu_node[placement->num_cpus] = 0;
+                placement->num_cpus++;
+            }
+        }
+        placement->node_ids[0] = 0;
+        node_first[0] = 0;
+        node_cpus[0] = placement->num_cpus;
+        placement->num_nodes = 1;
+    }
+
+    // Worker'lar node'lara ardışık bloklar halinde, node içinde CPU'lara sırayla
+    for (int w = 0; w < num_workers; w++) {
+        int n = (int)((long)w * placement->num_nodes / num_workers);
+        int first_worker = (int)(((long)n * num_workers + placement->num_nodes - 1) / placement->num_nodes);
+        int cpu = node_first[n] + (w - first_worker) % node_cpus[n];
+        placement->worker_cpu[w] = placement->cpus[cpu];
+        placement->worker_node[w] = n;
+    }
+
+    placement->counters = (WorkerCounter *)shared_alloc(num_workers * sizeof(WorkerCounter), "worker counters");
+    if (placement->counters == NULL) {
+        placement_destroy(placement);
+        return -1;
+    }
+    return 0;
+}
+
+void placement_destroy(Placement *placement) {
+    free(placement->cpus);
+    free(placement->cpu_node);
+    free(placement->worker_cpu);
+    free(placement->worker_node);
+    if (placement->counters != NULL) {
+        shared_free(placement->counters);
+        placement->counters = NULL;
+    }
+}
+
+void placement_pin(const Placement *placement, int worker) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(placement->worker_cpu[worker], &set);
+    // pid 0: çağıran thread (fork edilen worker'da process'in tek thread'i)
+    if (sched_setaffinity(0, sizeof(set), &set) == -1) {
+        fprintf(stderr, "Warning: could not pin worker %d to CPU %d: %s\n", worker,
+                placement->worker_cpu[worker], strerror(errno));
+    }
+}
+
+// [start, end) aralığındaki sayfalara bellek politikası koyar; dokunulmuş sayfalar taşınır
+static void bind_pages(uintptr_t start, uintptr_t end, int mode, unsigned long nodemask) {
+    if (end <= start) {
+        return;
+    }
+    // maxnode: kernel maskenin maxnode - 1 bitini okur
+    if (syscall(SYS_mbind, (void *)start, end - start, mode, &nodemask,
+                (unsigned long)PLACEMENT_MAX_NODES + 1, MPOL_MF_MOVE) == -1 && !mbind_warned) {
+        fprintf(stderr, "Warning: mbind failed, memory stays where the kernel puts it: %s\n",
+                strerror(errno));
+        mbind_warned = 1;
+    }
+}
+
+static uintptr_t page_down(uintptr_t address) {
+    return address & ~(uintptr_t)(sysconf(_SC_PAGESIZE) - 1);
+}
+
+static uintptr_t page_up(uintptr_t address) {
+    return page_down(address + sysconf(_SC_PAGESIZE) - 1);
+}
+
+void placement_interleave(const Placement *placement, void *area, size_t size) {
+    if (placement->memory == MEMORY_DEFAULT || placement->num_nodes < 2 || size == 0) {
+        return;
+    }
+    unsigned long nodemask = 0;
+    for (int n = 0; n < placement->num_nodes; n++) {
+        nodemask |= 1UL << placement->node_ids[n];
+    }
+    bind_pages(page_down((uintptr_t)area), page_up((uintptr_t)area + size), MPOL_INTERLEAVE, nodemask);
+}
+
+void placement_place_slots(const Placement *placement, void *area, size_t size, int num_slots) {
+    if (placement->memory != MEMORY_PARTITION || placement->num_nodes < 2 || size == 0 || num_slots == 0) {
+        placement_interleave(placement, area, size);
+        return;
+    }
+
+    // Worker w'nun aralığı: slot [w * span, (w + 1) * span); ShardSet ile aynı bölme
+    int num_workers = placement->num_workers;
+    int span = (num_slots + num_workers - 1) / num_workers;
+    size_t element = size / num_slots;
+    uintptr_t base = (uintptr_t)area;
+    for (int w = 0; w < num_workers && (long)w * span < num_slots; w++) {
+        long last = (long)(w + 1) * span < num_slots ? (long)(w + 1) * span : num_slots;
+        // Sınırdaki sayfa, ilk slot'u o sayfaya düşen worker'a aittir
+        uintptr_t start = w == 0 ? page_down(base) : page_up(base + (size_t)w * span * element);
+        uintptr_t end = last == num_slots ? page_up(base + size) : page_up(base + (size_t)last * element);
+        int node = placement->node_ids[placement->worker_node[w]];
+        bind_pages(start, end, MPOL_PREFERRED, 1UL << node);
+    }
+}
+
+// Node'un worker'larının CPU'larını "0,1,2" biçiminde yazar (CPU'dan fazla worker varsa her CPU bir kez)
+static void format_cpus(const Placement *placement, int n, char *text, size_t size) {
+    size_t used = 0;
+    text[0] = '\0';
+    for (int w = 0; w < placement->num_workers && used < size; w++) {
+        if (placement->worker_node[w] != n) {
+            continue;
+        }
+        int seen = 0;
+        for (int v = 0; v < w && !seen; v++) {
+            seen = placement->worker_node[v] == n && placement->worker_cpu[v] == placement->worker_cpu[w];
+        }
+        if (!seen) {
+            used += snprintf(text + used, size - used, used == 0 ? "%d" : ",%d", placement->worker_cpu[w]);
+        }
+    }
+}
+
+void placement_report(const Placement *placement, long run_ns) {
+    const char *memory = "default";
+    if (placement->memory != MEMORY_DEFAULT && placement->num_nodes < 2) {
+        memory = "placement skipped (single node)";
+    } else if (placement->memory == MEMORY_INTERLEAVE) {
+        memory = "interleaved across nodes";
+    } else if (placement->memory == MEMORY_PARTITION) {
+        memory = "partitioned by account range";
+    }
+    printf("\nPlacement: %d NUMA node%s, %d worker%s pinned to cores, memory %s\n", placement->num_nodes,
+           placement->num_nodes == 1 ? "" : "s", placement->num_workers, placement->num_workers == 1 ? "" : "s",
+           memory);
+
+    double seconds = run_ns / 1e9;
+    for (int n = 0; n < placement->num_nodes; n++) {
+        int workers = 0;
+        long transactions = 0;
+        for (int w = 0; w < placement->num_workers; w++) {
+            if (placement->worker_node[w] == n) {
+                workers++;
+                transactions += placement->counters[w].transactions;
+            }
+        }
+        char cpus[256];
+        format_cpus(placement, n, cpus, sizeof(cpus));
+        printf("Node %d: %d worker%s on CPUs %s, %ld transactions (%.0f transactions/s)\n",
+               placement->node_ids[n], workers, workers == 1 ? "" : "s", workers > 0 ? cpus : "-", transactions,
+               seconds > 0 ? transactions / seconds : 0.0);
+    }
+}
@@ -0,0 +1,456 @@
+#include "../include/pool.h"          // WorkQueue ve pool fonksiyonları
+#include "../include/transactions.h"  // execute_transaction, SUCCESS / FAILURE
+#include "../include/utils.h"         // fork, wait, futex_wait / futex_wake
+#include "../include/aggregate.h"     // DEPOSIT_UNMERGED
+#include <pthread.h>                  // pthread_create / pthread_join (-e threads)
+
+// Dalga veya sıra beklerken CPU'yu bırakmadan önce kaç kez dönülsün
+#define SCHEDULE_SPIN_LIMIT 100
+
+void work_queue_init(WorkQueue *queue) {
+    queue->claimed = 0;
+    queue->available = 0;
+    queue->finished = 0;
+    queue->publish_seq = 0;
+    queue->gate = NULL;
+    queue->stats = NULL;
+    queue->schedule = SCHEDULE_NONE;
+    queue->turns = NULL;
+    queue->shards = NULL;
+    queue->engine = ENGINE_PROCESSES;
+    queue->threads = NULL;
+    queue->placement = NULL;
+    queue->completed = 0;
+}
+
+// -m sched / -m ordered: sayaç target'a ulaşana kadar bekler (önceki dalga veya hesabın
+// önceki işlemi kısa sürdüğü için önce döner, sonra CPU'yu bırakır; tek çekirdekte
+// beklenen işlemi çalıştıracak worker'a sıra gelir)
+static void wait_counter(const long *counter, long target) {
+    int spin = 0;
+    while (__atomic_load_n(counter, __ATOMIC_ACQUIRE) < target) {
+        if (++spin < SCHEDULE_SPIN_LIMIT) {
+            cpu_relax();
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+// İşlem i yayınlanana kadar bekler
+// Dönüş: 1 ise işlem hazır, 0 ise dosya bitti ve böyle bir işlem yok
+static int wait_available(WorkQueue *queue, long i) {
+    for (;;) {
+        // Önce sırayı oku: ardından gelen kontrol ile uyku arasında yayın kaçmaz
+        int seq = __atomic_load_n(&queue->publish_seq, __ATOMIC_ACQUIRE);
+        if (i < __atomic_load_n(&queue->available, __ATOMIC_ACQUIRE)) {
+            return 1;
+        }
+        if (__atomic_load_n(&queue->finished, __ATOMIC_ACQUIRE)) {
+            return 0;
+        }
+        futex_wait(&queue->publish_seq, seq);
+    }
+}
+
+// Parçanın bir yerini tamamlanmış sayar; son yerse ana process'i uyandırır
+static void chunk_place_done(Chunk *chunk) {
+    if (__atomic_add_fetch(&chunk->done, 1, __ATOMIC_RELEASE) == chunk->span) {
+        futex_wake(&chunk->done, 1);
+    }
+}
+
+// Biten işlemin sonucunu parçaya yazar; parçanın son işlemiyse ana process'i uyandırır
+static void finish_transaction(Chunk *chunk, int offset, int result) {
+    chunk->results[offset] = result;
+    chunk_place_done(chunk);
+}
+
+// -m ordered: işlemin dokunduğu her hesapta sırasını bekler (release 0) veya sırayı
+// hesabın bir sonraki işlemine verir (release 1, bakiye yazıldıktan sonra)
+// Çok ayaklı işlemin sıraları ayaklarının yanındadır
+static void pass_turns(WorkQueue *queue, const Chunk *chunk, int offset, int release) {
+    const int *slots = chunk->turn_slot[offset];
+    const long *turns = chunk->turn[offset];
+    int n = 2;
+    const Transaction *txn = &chunk->txns[offset];
+    if (txn->type == MULTI_LEG) {
+        slots = &chunk->leg_turn_slot[txn->from_account];
+        turns = &chunk->leg_turn[txn->from_account];
+        n = (int)txn->to_account;
+    }
+    for (int h = 0; h < n; h++) {
+        if (slots[h] == -1) {
+            continue;
+        }
+        if (release) {
+            __atomic_store_n(&queue->turns[slots[h]], turns[h] + 1, __ATOMIC_RELEASE);
+        } else {
+            wait_counter(&queue->turns[slots[h]], turns[h]);
+        }
+    }
+}
+
+// Parçadaki offset. işlemi çalıştırır; ön toplanmış yatırma payıyla çalışır (-d)
+static int run_transaction(Chunk *chunk, int offset, AccountTable *table, LogRing *logs, LockSet *locks) {
+    const Transaction *txn = &chunk->txns[offset];
+    int transaction_id = chunk_transaction_id(chunk, offset);
+    if (chunk->aggregated && chunk->deposit_total[offset] != DEPOSIT_UNMERGED) {
+        return process_deposit_run(table, logs, txn->to_account, txn->amount,
+                                   chunk->deposit_total[offset], transaction_id, locks);
+    }
+    return execute_transaction(table, logs, txn, chunk->legs, transaction_id, locks);
+}
+
+// İşlem indeksi → parçası ve parçadaki yeri
+static Chunk *chunk_of(WorkQueue *queue, long i, int *offset) {
+    *offset = (int)(i % CHUNK_SIZE);
+    return &queue->chunks[(i / CHUNK_SIZE) % CHUNK_SLOTS];
+}
+
+// Her worker'ın döngüsü: dosya bitene kadar işlem çek ve çalıştır
+// worker: Worker'ın numarası (snapshot kapısındaki bayrağı ve ölçüm histogramı)
+static void worker_loop(WorkQueue *queue, int worker, AccountTable *table, LogRing *logs, LockSet *locks) {
+    if (queue->placement != NULL) {
+        placement_pin(queue->placement, worker);
+    }
+
+    // Ölçüm açıksa worker kendi histogramına yazar (kilit bekleme süresi dahil)
+    LatencyHistogram *histogram = NULL;
+    if (queue->stats != NULL) {
+        histogram = &queue->stats->slots[worker];
+        locks->wait_ns = &histogram->lock_wait_ns;  // Child'ın kendi LockSet kopyası
+    }
+
+    for (;;) {
+        // Sıradaki işlemi atomik olarak al (iki worker aynı işlemi alamaz)
+        long i = __atomic_fetch_add(&queue->claimed, 1, __ATOMIC_RELAXED);
+        if (!wait_available(queue, i)) {
+            break;  // Kuyruk bitti
+        }
+
+        // Parça, içindeki son işlem bitmeden geri kullanılmaz; bu yüzden güvenle okunur
+        int offset;
+        Chunk *chunk = chunk_of(queue, i, &offset);
+        if (offset >= chunk->count) {
+            // Tekrar deneme parçasının boş yeri; parça tüm yerleri sayılmadan geri kullanılmaz
+            chunk_place_done(chunk);
+            continue;
+        }
+        if (queue->schedule == SCHEDULE_WAVES) {
+            // Çalıştırma sırasındaki yer → parçadaki yer; önceki dalgaların bakiyeleri
+            // completed'ın acquire okuması ile görünür olur
+            wait_counter(&queue->completed, chunk->wave_gate[offset]);
+            offset = chunk->order[offset];
+        } else if (queue->schedule == SCHEDULE_TURNS) {
+            // Hesapların önceki işlemleri daha küçük indeksli olduğu için zaten alınmıştır
+            // ve bitecektir (deadlock yok); bakiyeleri turns'ün acquire okuması ile görünür olur
+            pass_turns(queue, chunk, offset, 0);
+        }
+        if (queue->gate != NULL) {
+            // İşlemin epoch'u: hesaplara bu epoch'un sürüm etiketiyle yazılır
+            table->write_epoch = snapshot_gate_enter(queue->gate, worker);
+        }
+        long start = histogram != NULL ? now_ns() : 0;
+        int result = run_transaction(chunk, offset, table, logs, locks);
+        if (histogram != NULL) {
+            latency_record(histogram, now_ns() - start);
+        }
+        placement_count(queue->placement, worker);
+        if (queue->gate != NULL) {
+            snapshot_gate_leave(queue->gate, worker);
+        }
+        if (queue->schedule == SCHEDULE_WAVES) {
+            __atomic_add_fetch(&queue->completed, 1, __ATOMIC_RELEASE);
+        } else if (queue->schedule == SCHEDULE_TURNS) {
+            // Sırayı hesabın bir sonraki işlemine ver (bakiye yazıldıktan sonra, release)
+            pass_turns(queue, chunk, offset, 1);
+        }
+
+        // Parçanın son işlemini bitiren ana process'i uyandırır
+        finish_transaction(chunk, offset, result);
+    }
+}
+
+// -m shard: işlemi tamamlar ve shard'ın sayacını arttırır (sayaca sadece sahibi yazar)
+static void shard_finish(WorkQueue *queue, int shard, Chunk *chunk, int offset, int result) {
+    finish_transaction(chunk, offset, result);
+    ShardState *state = &queue->shards->state[shard];
+    __atomic_store_n(&state->settled, state->settled + 1, __ATOMIC_RELEASE);
+}
+
+// -m shard: başka shard'ın borcunu düştüğü transferin alacak yarısı
+static void shard_credit(WorkQueue *queue, int shard, long i, AccountTable *table, LogRing *logs) {
+    int offset;
+    Chunk *chunk = chunk_of(queue, i, &offset);
+    const Transaction *txn = &chunk->txns[offset];
+    int result = process_transfer_credit(table, logs, txn->from_account, txn->to_account, txn->amount,
+                                         chunk_transaction_id(chunk, offset));
+    shard_finish(queue, shard, chunk, offset, result);
+}
+
+// -m shard: shard'a gelen tüm alacak mesajlarını işler
+// Dönüş: İşlenen mesaj sayısı
+static int shard_drain_credits(WorkQueue *queue, int shard, AccountTable *table, LogRing *logs) {
+    ShardSet *shards = queue->shards;
+    int handled = 0;
+    long i;
+    for (int from = 0; from < shards->num_shards; from++) {
+        ShardQueue *link = &shards->links[from * shards->num_shards + shard];
+        while (shard_queue_pop(link, &i)) {
+            shard_credit(queue, shard, i, table, logs);
+            handled++;
+        }
+    }
+    return handled;
+}
+
+// -m shard: ana process'ten gelen bir işlemi çalıştırır
+// Hedef hesap başka shard'daysa transferin sadece borç yarısı burada yapılır; borç
+// kabul edilirse alacak yarısı hedef shard'a gönderilir, reddedilirse işlem burada biter
+static void shard_execute(WorkQueue *queue, int shard, long i, AccountTable *table, LogRing *logs, LockSet *locks) {
+    ShardSet *shards = queue->shards;
+    int offset;
+    Chunk *chunk = chunk_of(queue, i, &offset);
+    const Transaction *txn = &chunk->txns[offset];
+    int transaction_id = chunk_transaction_id(chunk, offset);
+
+    int result;
+    int to_slot = txn->type == TRANSFER ? account_table_find(table, txn->to_account) : -1;
+    if (to_slot != -1 && shard_of(shards, to_slot) != shard) {
+        result = process_transfer_debit(table, logs, txn->from_account, txn->to_account, txn->amount,
+                                        transaction_id, locks);
+        if (result == SUCCESS) {
+            int target = shard_of(shards, to_slot);
+            ShardQueue *link = &shards->links[shard * shards->num_shards + target];
+            while (!shard_queue_push(link, i)) {
+                // Hedef shard da bize alacak gönderemiyor olabilir: beklerken kendi
+                // alacaklarımızı işleriz (alacak mesaj üretmez, deadlock oluşmaz)
+                shard_notify(shards, target);
+                if (shard_drain_credits(queue, shard, table, logs) == 0) {
+                    sched_yield();
+                }
+            }
+            shard_notify(shards, target);
+            return;  // İşlemi hedef shard tamamlar
+        }
+    } else {
+        // Çok ayaklı işlem buraya ya tüm ayakları bu shard'dayken ya da ana process'in
+        // bariyeri arkasında (diğer shard'lar boşken) gelir
+        result = run_transaction(chunk, offset, table, logs, locks);
+    }
+    shard_finish(queue, shard, chunk, offset, result);
+}
+
+// Tüm shard'larda tamamlanan işlem sayısı
+static long shards_settled(const ShardSet *shards) {
+    long total = 0;
+    for (int s = 0; s < shards->num_shards; s++) {
+        total += __atomic_load_n(&shards->state[s].settled, __ATOMIC_ACQUIRE);
+    }
+    return total;
+}
+
+// -m shard: worker'ın döngüsü; alacaklar önce işlenir ki diğer shard'ların kuyrukları dolmasın
+static void shard_loop(WorkQueue *queue, int shard, AccountTable *table, LogRing *logs, LockSet *locks) {
+    ShardSet *shards = queue->shards;
+    LatencyHistogram *histogram = queue->stats != NULL ? &queue->stats->slots[shard] : NULL;
+    ShardQueue *inbox = &shards->inbox[shard];
+    if (queue->placement != NULL) {
+        placement_pin(queue->placement, shard);  // -N partition: shard'ın hesapları bu node'da
+    }
+
+    for (;;) {
+        int handled = shard_drain_credits(queue, shard, table, logs);
+        long i;
+        while (handled < SHARD_QUEUE_SIZE && shard_queue_pop(inbox, &i)) {
+            // Gecikme: bu shard'daki kısım (karşı shard'daki alacak yarısı dahil değil)
+            long start = histogram != NULL ? now_ns() : 0;
+            shard_execute(queue, shard, i, table, logs, locks);
+            if (histogram != NULL) {
+                latency_record(histogram, now_ns() - start);
+            }
+            placement_count(queue->placement, shard);
+            handled++;
+        }
+        if (handled > 0) {
+            continue;
+        }
+
+        if (__atomic_load_n(&queue->finished, __ATOMIC_ACQUIRE)) {
+            // Dosya bitti: tüm işlemler tamamlanınca çık; o zamana kadar başka
+            // shard'lardan alacak gelebilir (son işlemler kısa sürdüğü için uyunmaz)
+            if (shards_settled(shards) == __atomic_load_n(&queue->available, __ATOMIC_ACQUIRE)) {
+                break;
+            }
+            sched_yield();
+        } else {
+            shard_idle(shards, shard, &queue->finished);
+        }
+    }
+}
+
+// -e threads: bir worker thread'inin durumu; table ve locks fork edilen worker'daki
+// gibi thread'in kendi kopyasıdır (write_epoch ve wait_ns thread'e özeldir)
+typedef struct WorkerThread {
+    pthread_t thread;
+    WorkQueue *queue;
+    int worker;
+    AccountTable table;
+    LogRing *logs;
+    LockSet locks;
+} WorkerThread;
+
+static void *worker_thread_main(void *arg) {
+    WorkerThread *self = (WorkerThread *)arg;
+    if (self->queue->shards != NULL) {
+        shard_loop(self->queue, self->worker, &self->table, self->logs, &self->locks);
+    } else {
+        worker_loop(self->queue, self->worker, &self->table, self->logs, &self->locks);
+    }
+    return NULL;
+}
+
+// -e threads: num_workers thread başlatır
+static int start_worker_threads(WorkQueue *queue, int num_workers, AccountTable *table, LogRing *logs,
+                                LockSet *locks) {
+    WorkerThread *threads = (WorkerThread *)calloc(num_workers, sizeof(WorkerThread));
+    if (threads == NULL) {
+        perror("calloc failed for worker threads");
+        return 0;
+    }
+    queue->threads = threads;
+    int started = 0;
+    for (int w = 0; w < num_workers; w++) {
+        threads[w].queue = queue;
+        threads[w].worker = w;
+        threads[w].table = *table;
+        threads[w].logs = logs;
+        threads[w].locks = *locks;
+        int error = pthread_create(&threads[w].thread, NULL, worker_thread_main, &threads[w]);
+        if (error != 0) {
+            fprintf(stderr, "pthread_create failed for pool worker: %s\n", strerror(error));
+            break;
+        }
+        started++;
+    }
+    return started;
+}
+
+int start_worker_pool(WorkQueue *queue, int num_workers, AccountTable *table, LogRing *logs, LockSet *locks) {
+    if (queue->engine == ENGINE_THREADS) {
+        return start_worker_threads(queue, num_workers, table, logs, locks);
+    }
+
+    // Fork öncesi tamponu boşalt, yoksa child'lar aynı çıktıyı tekrar yazar
+    fflush(stdout);
+
+    int started = 0;
+    for (int w = 0; w < num_workers; w++) {
+        pid_t pid = fork();
+        if (pid == -1) {
+            perror("fork failed for pool worker");
+            break;
+        } else if (pid == 0) {  // Worker process
+            if (queue->shards != NULL) {
+                shard_loop(queue, w, table, logs, locks);
+            } else {
+                worker_loop(queue, w, table, logs, locks);
+            }
+            _exit(EXIT_SUCCESS);
+        }
+        started++;
+    }
+    return started;
+}
+
+// -m shard: ana process, tüm shard'larda toplam settled işlem olana kadar bekler
+// (shard'lar uyuyorsa uyandırılır; bekleyen işlemler kısa olduğu için CPU bırakılarak döner)
+static void shard_barrier(WorkQueue *queue, long settled) {
+    ShardSet *shards = queue->shards;
+    for (int s = 0; s < shards->num_shards; s++) {
+        shard_notify(shards, s);
+    }
+    while (shards_settled(shards) < settled) {
+        sched_yield();
+    }
+}
+
+void publish_chunk(WorkQueue *queue, Chunk *chunk, int count) {
+    chunk->count = count;
+    chunk->span = chunk->retry && queue->shards == NULL ? CHUNK_SIZE : count;
+    chunk->done = 0;
+
+    // İşlemler yazıldıktan sonra görünür olsun (release)
+    __atomic_add_fetch(&queue->available, chunk->span, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&queue->publish_seq, 1, __ATOMIC_RELEASE);
+    futex_wake(&queue->publish_seq, 0x7fffffff);  // Bekleyen tüm worker'lar
+
+    // -m shard: her işlem, sahibi olan shard'ın kuyruğuna; shard'lar parça sonunda bir kez uyandırılır
+    ShardSet *shards = queue->shards;
+    if (shards != NULL) {
+        long base = chunk->base_id;
+        for (int j = 0; j < count; j++) {
+            int spans;
+            int home = shard_home(shards, &chunk->txns[j], chunk->legs, &spans);
+            if (spans) {
+                shard_barrier(queue, base + j);  // Önceki tüm işlemler bitsin
+            }
+            while (!shard_queue_push(&shards->inbox[home], base + j)) {
+                shard_notify(shards, home);  // Kuyruk dolu: shard uyuyorsa boşaltsın
+                sched_yield();
+            }
+            if (spans) {
+                shard_notify(shards, home);
+                shard_barrier(queue, base + j + 1);  // Sonrakiler ancak bu bitince
+            }
+        }
+        for (int s = 0; s < shards->num_shards; s++) {
+            shard_notify(shards, s);
+        }
+    }
+}
+
+void finish_work_queue(WorkQueue *queue) {
+    __atomic_store_n(&queue->finished, 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&queue->publish_seq, 1, __ATOMIC_RELEASE);
+    futex_wake(&queue->publish_seq, 0x7fffffff);
+    if (queue->shards != NULL) {
+        for (int s = 0; s < queue->shards->num_shards; s++) {
+            shard_notify(queue->shards, s);
+        }
+    }
+}
+
+void wait_chunk(Chunk *chunk) {
+    int done;
+    while ((done = __atomic_load_n(&chunk->done, __ATOMIC_ACQUIRE)) < chunk->span) {
+        futex_wait(&chunk->done, done);
+    }
+}
+
+int wait_worker_pool(WorkQueue *queue, int num_started) {
+    if (queue->engine == ENGINE_THREADS) {
+        int result = 0;
+        for (int w = 0; w < num_started; w++) {
+            int error = pthread_join(queue->threads[w].thread, NULL);
+            if (error != 0) {
+                fprintf(stderr, "pthread_join failed for pool worker: %s\n", strerror(error));
+                result = -1;
+            }
+        }
+        free(queue->threads);
+        queue->threads = NULL;
+        return result;
+    }
+
+    // Tüm worker'ları bekle (sonuçlar shared memory'de, exit kodu önemli değil)
+    for (int w = 0; w < num_started; w++) {
+        int status;
+        if (wait(&status) == -1) {
+            perror("wait failed for pool worker");
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include "../include/retry.h"         // RetryQueue
+#include "../include/transactions.h"  // WITHDRAW, TRANSFER, MULTI_LEG, SUCCESS
+#include <stdlib.h>                   // realloc, free
+#include <string.h>                   // memset, memcpy
+#include <time.h>                     // nanosleep
+
+void retry_queue_init(RetryQueue *queue, const AccountTable *table, int max_attempts, int backoff_ms) {
+    memset(queue, 0, sizeof(*queue));
+    queue->table = table;
+    queue->max_attempts = max_attempts;
+    queue->backoff_ms = backoff_ms;
+}
+
+void retry_queue_destroy(RetryQueue *queue) {
+    for (int k = 0; k < queue->count; k++) {
+        free(queue->items[k].legs);
+    }
+    free(queue->items);
+    free(queue->taken);
+}
+
+// Çok ayaklı işlemin ilk borçlu ayağının slot'u
+// Dönüş: Slot; bilinmeyen hesap varsa veya borçlu ayak yoksa -1
+static int first_debit_slot(const AccountTable *table, const Leg *legs, int num_legs) {
+    int slot = -1;
+    for (int k = 0; k < num_legs; k++) {
+        int leg_slot = account_table_find(table, legs[k].account_id);
+        if (leg_slot == -1) {
+            return -1;  // Hesap sonradan oluşmaz
+        }
+        if (slot == -1 && legs[k].amount < 0) {
+            slot = leg_slot;
+        }
+    }
+    return slot;
+}
+
+void retry_queue_park(RetryQueue *queue, int transaction_id, const Transaction *txn, const Leg *legs,
+                      long failed_ns) {
+    // Sadece yetersiz bakiye yüzünden başarısız olan para çıkışları bakiye artınca düzelebilir
+    int slot = -1;
+    if (txn->type == WITHDRAW || txn->type == TRANSFER) {
+        slot = account_table_find(queue->table, txn->from_account);
+    } else if (txn->type == MULTI_LEG && legs != NULL) {
+        slot = first_debit_slot(queue->table, legs + txn->from_account, (int)txn->to_account);
+    }
+    if (slot == -1 || (txn->type == TRANSFER && account_table_find(queue->table, txn->to_account) == -1)) {
+        queue->not_retryable++;
+        return;
+    }
+
+    if (queue->count == queue->capacity) {
+        queue->capacity = queue->capacity == 0 ? 64 : queue->capacity * 2;
+        queue->items = (RetryItem *)realloc(queue->items, queue->capacity * sizeof(RetryItem));
+        queue->taken = (int *)realloc(queue->taken, queue->capacity * sizeof(int));
+    }
+    RetryItem *item = &queue->items[queue->count++];
+    item->transaction_id = transaction_id;
+    item->txn = *txn;
+    item->legs = NULL;
+    if (txn->type == MULTI_LEG) {
+        item->legs = (Leg *)malloc(txn->to_account * sizeof(Leg));
+        memcpy(item->legs, legs + txn->from_account, txn->to_account * sizeof(Leg));
+        item->txn.from_account = 0;
+    }
+    item->slot = slot;
+    item->attempts = 0;
+    item->failed_ns = failed_ns;
+    item->due_ns = failed_ns;  // İlk deneme için beklenmez
+    queue->parked++;
+}
+
+// Hesabın bakiyesi amount'u karşılıyor mu? (worker'lar yazıyor olabilir: atomik okuma)
+static int covers(const RetryQueue *queue, int slot, int amount) {
+    return __atomic_load_n(account_balance(queue->table, slot), __ATOMIC_RELAXED) >= amount;
+}
+
+// Bakiye işlemi karşılıyor mu? Çok ayaklı işlemde her borçlu ayak ayrı ayrı
+// (process_multi_leg'in ilk geçişi gibi)
+static int funds_ready(const RetryQueue *queue, const RetryItem *item) {
+    if (item->txn.type != MULTI_LEG) {
+        return covers(queue, item->slot, item->txn.amount);
+    }
+    for (int k = 0; k < item->txn.to_account; k++) {
+        const Leg *leg = &item->legs[k];
+        if (leg->amount < 0 && !covers(queue, account_table_find(queue->table, leg->account_id), -leg->amount)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int retry_queue_take(RetryQueue *queue, Transaction *txns, int *ids, Leg *legs, int max, int wait) {
+    for (;;) {
+        long now = now_ns();
+        long next_due = 0;  // Bakiyesi yeten ama backoff'u dolmamış en erken işlem (0: yok)
+        int num_legs = 0;   // legs içinde kullanılan yer
+        queue->num_taken = 0;
+        for (int k = 0; k < queue->count && queue->num_taken < max; k++) {
+            RetryItem *item = &queue->items[k];
+            if (!funds_ready(queue, item)) {
+                continue;  // Hesaba para gelene kadar bekler
+            }
+            if (item->due_ns > now) {
+                if (next_due == 0 || item->due_ns < next_due) {
+                    next_due = item->due_ns;
+                }
+                continue;
+            }
+            txns[queue->num_taken] = item->txn;
+            if (item->txn.type == MULTI_LEG) {
+                memcpy(legs + num_legs, item->legs, item->txn.to_account * sizeof(Leg));
+                txns[queue->num_taken].from_account = num_legs;
+                num_legs += (int)item->txn.to_account;
+            }
+            ids[queue->num_taken] = item->transaction_id;
+            queue->taken[queue->num_taken++] = k;
+        }
+        if (queue->num_taken > 0 || next_due == 0 || !wait) {
+            if (queue->num_taken > 0) {
+                queue->rounds++;
+            }
+            return queue->num_taken;
+        }
+
+        // Bakiyeler sadece tekrar denemelerle değişir: en erken backoff'a kadar uyu
+        long wait = next_due - now;
+        struct timespec ts = { wait / 1000000000L, wait % 1000000000L };
+        nanosleep(&ts, NULL);
+    }
+}
+
+void retry_queue_settle(RetryQueue *queue, const int *results) {
+    long now = now_ns();
+    for (int k = 0; k < queue->num_taken; k++) {
+        RetryItem *item = &queue->items[queue->taken[k]];
+        item->attempts++;
+        queue->attempts++;
+        if (results[k] == SUCCESS) {
+            latency_record(&queue->latency, now - item->failed_ns);
+            queue->succeeded++;
+            item->slot = -1;  // Kuyruktan çıkacak
+        } else if (item->attempts >= queue->max_attempts) {
+            queue->exhausted++;
+            item->slot = -1;
+        } else {
+            // Aynı turdaki başka bir işlem parayı önce kullandı: backoff her denemede iki katı
+            int shift = item->attempts - 1 < RETRY_MAX_BACKOFF_SHIFT ? item->attempts - 1 : RETRY_MAX_BACKOFF_SHIFT;
+            item->due_ns = now + ((long)queue->backoff_ms * 1000000L << shift);
+        }
+    }
+    queue->num_taken = 0;
+
+    // Çıkan işlemleri sırayı bozmadan sil
+    int kept = 0;
+    for (int k = 0; k < queue->count; k++) {
+        if (queue->items[k].slot != -1) {
+            queue->items[kept++] = queue->items[k];
+        } else {
+            free(queue->items[k].legs);
+        }
+    }
+    queue->count = kept;
+}
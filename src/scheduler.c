@@ -0,0 +1,162 @@
+#include "../include/scheduler.h"     // Scheduler
+#include "../include/transactions.h"  // DEPOSIT, WITHDRAW, TRANSFER, MULTI_LEG
+#include "../include/utils.h"         // shared_alloc
+#include "../include/aggregate.h"     // DEPOSIT_FOLDED
+#include <stdlib.h>                   // calloc, free
+#include <string.h>                   // memset, memcpy
+
+int scheduler_init(Scheduler *scheduler, ScheduleKind kind, const AccountTable *table) {
+    int n = table->num_accounts > 0 ? table->num_accounts : 1;
+    memset(scheduler, 0, sizeof(*scheduler));
+    scheduler->kind = kind;
+    scheduler->table = table;
+    if (kind == SCHEDULE_WAVES) {
+        scheduler->last_wave = (int *)calloc(n, sizeof(int));
+        scheduler->stamp = (int *)calloc(n, sizeof(int));  // 0: hiçbir parçada görülmedi
+        return 0;
+    }
+
+    // Sıra sayaçları worker'lar arasında paylaşılır
+    long *turns = (long *)shared_alloc((size_t)n * sizeof(long), "account turns");
+    if (turns == NULL) {
+        return -1;
+    }
+    scheduler->turns = turns;  // Sıfırlanmış gelir: her hesapta 0. işlemin sırası
+    scheduler->issued = (long *)calloc(n, sizeof(long));
+    scheduler->depth = (int *)calloc(n, sizeof(int));
+    return 0;
+}
+
+void scheduler_destroy(Scheduler *scheduler) {
+    free(scheduler->last_wave);
+    free(scheduler->stamp);
+    free(scheduler->issued);
+    free(scheduler->depth);
+    if (scheduler->turns != NULL) {
+        shared_free(scheduler->turns);
+    }
+}
+
+// Parçadaki j. işlemin dokunduğu hesapların slot'ları (bilinmeyen hesap ve işlem türü
+// hiçbir hesaba dokunmaz; çok ayaklı işlemin her ayağı bir hesaptır)
+// Ön toplamada katlanan yatırma bakiyeye dokunmaz: sıra almaz, kimseyi bekletmez (-d)
+static int touched_slots(const Scheduler *scheduler, const Chunk *chunk, int j, int slots[MULTI_MAX_LEGS]) {
+    const Transaction *txn = &chunk->txns[j];
+    const Leg *legs = chunk->legs;
+    int n = 0;
+    if (chunk->aggregated && chunk->deposit_total[j] == DEPOSIT_FOLDED) {
+        return 0;
+    }
+    if (txn->type == MULTI_LEG) {
+        for (int k = 0; k < txn->to_account; k++) {
+            slots[n] = account_table_find(scheduler->table, legs[txn->from_account + k].account_id);
+            n += slots[n] != -1;
+        }
+        return n;
+    }
+    if (txn->type == WITHDRAW || txn->type == TRANSFER) {
+        slots[n] = account_table_find(scheduler->table, txn->from_account);
+        n += slots[n] != -1;
+    }
+    if (txn->type == DEPOSIT || txn->type == TRANSFER) {
+        slots[n] = account_table_find(scheduler->table, txn->to_account);
+        n += slots[n] != -1;
+    }
+    return n;
+}
+
+// SCHEDULE_TURNS: her işleme dokunduğu farklı hesaplardaki sırasını verir
+// Çok ayaklı işlemin sıraları ayaklarının yanına yazılır (ayakların hesapları zaten farklıdır)
+static void assign_turns(Scheduler *scheduler, Chunk *chunk, int count) {
+    for (int j = 0; j < count; j++) {
+        const Transaction *txn = &chunk->txns[j];
+        int slots[MULTI_MAX_LEGS];
+        int n = touched_slots(scheduler, chunk, j, slots);
+        if (n == 2 && slots[0] == slots[1]) {
+            n = 1;  // Hesabın kendisine transfer: aynı hesapta iki sıra almak kendini bekletir
+        }
+
+        // Zincir uzunluğu: dokunduğu hesaplardaki en uzun zincir + 1
+        int depth = 0;
+        for (int k = 0; k < n; k++) {
+            if (scheduler->depth[slots[k]] > depth) {
+                depth = scheduler->depth[slots[k]];
+            }
+        }
+        depth++;
+        if (depth > scheduler->longest_chain) {
+            scheduler->longest_chain = depth;
+        }
+
+        int *turn_slot = chunk->turn_slot[j];
+        long *turn = chunk->turn[j];
+        int width = 2;
+        if (txn->type == MULTI_LEG) {
+            turn_slot = &chunk->leg_turn_slot[txn->from_account];
+            turn = &chunk->leg_turn[txn->from_account];
+            width = (int)txn->to_account;
+        }
+        for (int h = 0; h < width; h++) {
+            if (h < n) {
+                turn_slot[h] = slots[h];
+                turn[h] = scheduler->issued[slots[h]]++;
+                scheduler->depth[slots[h]] = depth;
+            } else {
+                turn_slot[h] = -1;
+            }
+        }
+    }
+    scheduler->transactions += count;
+}
+
+void schedule_chunk(Scheduler *scheduler, Chunk *chunk, int count) {
+    if (scheduler->kind == SCHEDULE_TURNS) {
+        assign_turns(scheduler, chunk, count);
+        return;
+    }
+
+    int epoch = ++scheduler->epoch;
+    int num_waves = 0;
+
+    // 1. geçiş: her işlemin dalgası = dokunduğu hesapların son dalgası + 1
+    for (int j = 0; j < count; j++) {
+        int slots[MULTI_MAX_LEGS];
+        int n = touched_slots(scheduler, chunk, j, slots);
+        int wave = 0;
+        for (int k = 0; k < n; k++) {
+            if (scheduler->stamp[slots[k]] == epoch && scheduler->last_wave[slots[k]] >= wave) {
+                wave = scheduler->last_wave[slots[k]] + 1;
+            }
+        }
+        for (int k = 0; k < n; k++) {
+            scheduler->stamp[slots[k]] = epoch;
+            scheduler->last_wave[slots[k]] = wave;
+        }
+        scheduler->wave_of[j] = wave;
+        if (wave + 1 > num_waves) {
+            num_waves = wave + 1;
+        }
+    }
+
+    // 2. geçiş: dalga başlangıçları (sayma sıralaması)
+    memset(scheduler->wave_start, 0, (num_waves + 1) * sizeof(int));
+    for (int j = 0; j < count; j++) {
+        scheduler->wave_start[scheduler->wave_of[j] + 1]++;
+    }
+    for (int w = 1; w <= num_waves; w++) {
+        scheduler->wave_start[w] += scheduler->wave_start[w - 1];
+    }
+    memcpy(scheduler->wave_next, scheduler->wave_start, num_waves * sizeof(int));
+
+    // 3. geçiş: dalga içinde girdi sırası korunarak yerleştir; bir işlem, önceki
+    // parçalar ve kendi parçasının önceki dalgaları bitince başlayabilir
+    for (int j = 0; j < count; j++) {
+        int wave = scheduler->wave_of[j];
+        int pos = scheduler->wave_next[wave]++;
+        chunk->order[pos] = j;
+        chunk->wave_gate[pos] = (long)chunk->base_id + scheduler->wave_start[wave];
+    }
+
+    scheduler->waves += num_waves;
+    scheduler->transactions += count;
+}
@@ -0,0 +1,170 @@
+#include "../include/server.h"        // ServerState, server fonksiyonları
+#include "../include/transactions.h"  // execute_transaction, SUCCESS, transaction_journal_position
+#include "../include/logring.h"       // LogRing
+#include "../include/utils.h"         // shmget, shmat, close, unlink
+#include <signal.h>                   // sigaction
+#include <sys/socket.h>               // socket, bind, listen
+#include <sys/un.h>                   // sockaddr_un
+
+// Durma sinyali geldiğinde 1 olur (her process kendi kopyasını görür)
+static volatile sig_atomic_t stop_requested = 0;
+
+static void on_stop_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+void server_install_signals(void) {
+    // SA_RESTART yok: accept / read sinyal gelince EINTR ile döner ve bayrak kontrol edilir
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_stop_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);  // Kapanmış bağlantıya yazmak write() hatası olarak görülür
+}
+
+int server_stopping(void) {
+    return stop_requested;
+}
+
+int server_listen(const char *path) {
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Socket path is too long: %s\n", path);
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) {
+        perror("socket failed");
+        return -1;
+    }
+    unlink(path);  // Önceki çalıştırmadan kalan socket dosyası
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) == -1 || listen(fd, SOMAXCONN) == -1) {
+        perror("Error listening on socket");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+ServerState *server_state_create(void) {
+    int shm_id = shmget(IPC_PRIVATE, sizeof(ServerState), IPC_CREAT | 0666);
+    if (shm_id == -1) {
+        perror("shmget failed for server state");
+        return NULL;
+    }
+    ServerState *state = (ServerState *)shmat(shm_id, NULL, 0);
+    shmctl(shm_id, IPC_RMID, NULL);  // Son bağlantı kopunca kernel silsin
+    if (state == (void *)-1) {
+        perror("shmat failed for server state");
+        return NULL;
+    }
+    return state;  // shmget belleği sıfırlar: ilk işlem ID'si 0
+}
+
+// Tamponun tamamını yazar (kısa yazımlarda devam eder)
+// Dönüş: Başarılıysa 0, bağlantı koptuysa -1
+static int write_all(int fd, const void *data, size_t size) {
+    const char *p = (const char *)data;
+    while (size > 0) {
+        ssize_t written = write(fd, p, size);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;  // Cevaplar yarım bırakılmaz
+            }
+            return -1;
+        }
+        p += written;
+        size -= (size_t)written;
+    }
+    return 0;
+}
+
+long server_serve(int fd, AccountTable *table, LockSet *locks, ServerState *state, Journal *journal,
+                  LatencyHistogram *histogram) {
+    // Log kayıtları bu bağlantıya özel halkaya yazılır ve hemen atılır (kalıcı kayıt journal'dır)
+    LogRing *logs = log_ring_create(1);
+    if (logs == NULL) {
+        return -1;
+    }
+
+    WireRequest requests[WIRE_BATCH];
+    WireReply replies[WIRE_BATCH];
+    size_t buffered = 0;  // requests içindeki byte sayısı (son istek yarım olabilir)
+    long served = 0;
+
+    while (!stop_requested) {
+        ssize_t n = read(fd, (char *)requests + buffered, sizeof(requests) - buffered);
+        if (n == 0) {
+            break;  // İstemci bağlantıyı kapattı
+        }
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;  // Sinyal: döngü bayrağı kontrol eder
+            }
+            served = -1;
+            break;
+        }
+        buffered += (size_t)n;
+
+        // Tam gelen istekleri sırayla çalıştır, cevapları topla
+        int count = (int)(buffered / sizeof(WireRequest));
+        if (count > 0 && journal != NULL && journal_failed(journal)) {
+            // Yeni işlemler kalıcı olamaz: çalıştırma, bağlantıyı kapat
+            fprintf(stderr, "Journal writer failed, closing connection\n");
+            served = -1;
+            break;
+        }
+        for (int k = 0; k < count; k++) {
+            const WireRequest *request = &requests[k];
+            Transaction txn;
+            txn.from_account = request->from_account;
+            txn.to_account = request->to_account;
+            txn.type = request->type;
+            txn.amount = request->amount;
+            int transaction_id = (int)__atomic_fetch_add(&state->next_id, 1, __ATOMIC_RELAXED);
+
+            long start = histogram != NULL ? now_ns() : 0;
+            // İstek çerçevesi ayak taşımaz: çok ayaklı işlem (MULTI_LEG) FAILURE olur
+            int result = execute_transaction(table, logs, &txn, NULL, transaction_id, locks);
+            if (histogram != NULL) {
+                latency_record(histogram, now_ns() - start);
+            }
+            TransactionLog entry;
+            log_ring_pop(logs, &entry);
+
+            if (result != SUCCESS) {
+                __atomic_fetch_add(&state->failed, 1, __ATOMIC_RELAXED);
+            }
+            replies[k].tag = request->tag;
+            replies[k].transaction_id = transaction_id;
+            replies[k].status = result == SUCCESS ? LOG_SUCCESS : LOG_FAILED;
+        }
+        served += count;
+
+        // Yarım kalan istek tamponun başına taşınır
+        size_t used = (size_t)count * sizeof(WireRequest);
+        memmove(requests, (char *)requests + used, buffered - used);
+        buffered -= used;
+
+        // -j: cevap ancak batch'in son journal kaydı diske inince gider (group commit penceresi kadar)
+        if (count > 0 && journal != NULL && journal_wait_synced(journal, transaction_journal_position()) == -1) {
+            fprintf(stderr, "Journal writer failed, closing connection without replies\n");
+            served = -1;
+            break;
+        }
+        if (count > 0 && write_all(fd, replies, (size_t)count * sizeof(WireReply)) == -1) {
+            served = -1;
+            break;
+        }
+    }
+
+    log_ring_destroy(logs);
+    return served;
+}
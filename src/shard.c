@@ -0,0 +1,91 @@
+#include "../include/shard.h"         // ShardSet, ShardQueue
+#include "../include/transactions.h"  // DEPOSIT, WITHDRAW, TRANSFER, MULTI_LEG
+#include "../include/utils.h"         // shared_alloc, futex_wait / futex_wake
+
+int shard_set_create(ShardSet *set, int num_shards, const AccountTable *table) {
+    // Segment: state dizisi, arkasından inbox ve links kuyrukları (hepsi cache line hizalı)
+    size_t num_queues = (size_t)num_shards + (size_t)num_shards * num_shards;
+    size_t size = (size_t)num_shards * sizeof(ShardState) + num_queues * sizeof(ShardQueue);
+    void *area = shared_alloc(size, "shard queues");
+    if (area == NULL) {
+        return -1;
+    }
+
+    // Bellek sıfırlanmış gelir: tüm kuyruklar boş, hiçbir shard uyumuyor
+    set->table = table;
+    set->num_shards = num_shards;
+    set->span = (table->num_accounts + num_shards - 1) / num_shards;
+    if (set->span < 1) {
+        set->span = 1;
+    }
+    set->state = (ShardState *)area;
+    set->inbox = (ShardQueue *)(set->state + num_shards);
+    set->links = set->inbox + num_shards;
+    return 0;
+}
+
+void shard_set_destroy(ShardSet *set) {
+    shared_free(set->state);
+}
+
+int shard_home(const ShardSet *set, const Transaction *txn, const Leg *legs, int *spans) {
+    int slot = -1;
+    if (spans != NULL) {
+        *spans = 0;
+    }
+    if (txn->type == WITHDRAW || txn->type == TRANSFER) {
+        slot = account_table_find(set->table, txn->from_account);
+    } else if (txn->type == DEPOSIT) {
+        slot = account_table_find(set->table, txn->to_account);
+    } else if (txn->type == MULTI_LEG) {
+        // Ev: ilk ayağın shard'ı; diğer ayaklardan biri başka shard'daysa işlem dağılır
+        const Leg *txn_legs = legs + txn->from_account;
+        slot = account_table_find(set->table, txn_legs[0].account_id);
+        for (int k = 1; k < txn->to_account && slot != -1 && spans != NULL; k++) {
+            int other = account_table_find(set->table, txn_legs[k].account_id);
+            if (other != -1 && shard_of(set, other) != shard_of(set, slot)) {
+                *spans = 1;
+            }
+        }
+    }
+    return slot == -1 ? 0 : shard_of(set, slot);
+}
+
+// Kuyrukta okunmamış mesaj var mı? (tüketici tarafından, önbelleğe bakmadan)
+static int queue_nonempty(const ShardQueue *queue) {
+    return __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE) != queue->head;
+}
+
+int shard_pending(const ShardSet *set, int shard) {
+    if (queue_nonempty(&set->inbox[shard])) {
+        return 1;
+    }
+    for (int from = 0; from < set->num_shards; from++) {
+        if (queue_nonempty(&set->links[from * set->num_shards + shard])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void shard_notify(ShardSet *set, int shard) {
+    ShardState *state = &set->state[shard];
+    // Mesajın yazılması sleeping okumasından önce görünür olmalı (shard_idle ile simetrik)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&state->sleeping, __ATOMIC_RELAXED)) {
+        __atomic_add_fetch(&state->signal, 1, __ATOMIC_RELEASE);
+        futex_wake(&state->signal, 1);
+    }
+}
+
+void shard_idle(ShardSet *set, int shard, const int *stop) {
+    ShardState *state = &set->state[shard];
+    int seq = __atomic_load_n(&state->signal, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&state->sleeping, 1, __ATOMIC_RELAXED);
+    // sleeping yazılmadan kuyruklar okunursa, arada gelen mesajın üreticisi bizi uyandırmaz
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!shard_pending(set, shard) && !__atomic_load_n(stop, __ATOMIC_ACQUIRE)) {
+        futex_wait(&state->signal, seq);
+    }
+    __atomic_store_n(&state->sleeping, 0, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,230 @@
+#include "../include/snapshot.h"  // SnapshotGate, Snapshotter
+#include "../include/binfmt.h"    // read_binary_accounts, write_binary_accounts
+#include "../include/utils.h"     // shared_alloc, futex_wait, futex_wake
+
+SnapshotGate *snapshot_gate_create(int num_workers, int blocking) {
+    size_t size = sizeof(SnapshotGate) + num_workers * sizeof(WorkerFlag);
+    SnapshotGate *gate = (SnapshotGate *)shared_alloc(size, "snapshot gate");
+    if (gate == NULL) {
+        return NULL;
+    }
+
+    // Bellek sıfırlanmış gelir: kapı açık, epoch 0, hiçbir worker işlemde değil
+    gate->num_workers = num_workers;
+    gate->blocking = blocking;
+    return gate;
+}
+
+void snapshot_gate_destroy(SnapshotGate *gate) {
+    shared_free(gate);
+}
+
+int snapshot_gate_enter(SnapshotGate *gate, int worker) {
+    WorkerFlag *flag = &gate->workers[worker];
+    for (;;) {
+        // Önce bayrağa epoch'u yaz, sonra kapıya ve epoch'a tekrar bak (seq_cst: kesit alan
+        // taraf ile ikisinden biri mutlaka diğerini görür)
+        int epoch = __atomic_load_n(&gate->epoch, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&flag->busy, epoch + 1, __ATOMIC_SEQ_CST);
+        if (!__atomic_load_n(&gate->closed, __ATOMIC_SEQ_CST) &&
+            __atomic_load_n(&gate->epoch, __ATOMIC_SEQ_CST) == epoch) {
+            return epoch;
+        }
+
+        // Epoch bu arada ilerledi veya kapı kapalı: bayrağı indir, bekleyeni uyandır,
+        // kapı kapalıysa açılana kadar uyu ve yeni epoch ile tekrar dene
+        __atomic_store_n(&flag->busy, 0, __ATOMIC_SEQ_CST);
+        futex_wake(&flag->busy, 1);
+        while (__atomic_load_n(&gate->closed, __ATOMIC_ACQUIRE)) {
+            futex_wait(&gate->closed, 1);
+        }
+    }
+}
+
+void snapshot_gate_leave(SnapshotGate *gate, int worker) {
+    WorkerFlag *flag = &gate->workers[worker];
+    __atomic_store_n(&flag->busy, 0, __ATOMIC_SEQ_CST);
+    // Kesit alan taraf bu worker'ı bekliyorsa uyandır
+    if (__atomic_load_n(&gate->closed, __ATOMIC_SEQ_CST) ||
+        __atomic_load_n(&gate->draining, __ATOMIC_SEQ_CST)) {
+        futex_wake(&flag->busy, 1);
+    }
+}
+
+// epoch'tan önce başlamış tüm işlemlerin bitmesini bekler (bayrağı 0 veya epoch + 1 olana kadar)
+static void gate_drain(SnapshotGate *gate, int epoch) {
+    for (int w = 0; w < gate->num_workers; w++) {
+        WorkerFlag *flag = &gate->workers[w];
+        for (;;) {
+            int busy = __atomic_load_n(&flag->busy, __ATOMIC_SEQ_CST);
+            if (busy == 0 || busy == epoch + 1) {
+                break;
+            }
+            futex_wait(&flag->busy, busy);
+        }
+    }
+}
+
+// Kapıyı kapatır ve yarım kalmış tüm işlemlerin bitmesini bekler
+static void gate_close(SnapshotGate *gate) {
+    __atomic_store_n(&gate->closed, 1, __ATOMIC_SEQ_CST);
+    // Kapalı kapıdan yeni epoch ile de kimse geçemez: -1 hiçbir bayrakla eşleşmez
+    gate_drain(gate, -1);
+}
+
+// Kapıyı açar ve bekleyen worker'ları uyandırır
+static void gate_open(SnapshotGate *gate) {
+    __atomic_store_n(&gate->closed, 0, __ATOMIC_RELEASE);
+    futex_wake(&gate->closed, 0x7fffffff);
+}
+
+// Epoch'u ilerletir ve önceki epoch'ta başlamış işlemlerin bitmesini bekler; worker'lar
+// hiç beklemez, yeni işlemler yeni epoch ile başlar
+// Dönüş: Yeni epoch (kesit bu epoch'un başındaki durumdur)
+static int gate_advance(SnapshotGate *gate) {
+    int epoch = gate->epoch + 1;  // epoch'a sadece kesit alan process yazar
+    __atomic_store_n(&gate->epoch, epoch, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&gate->draining, 1, __ATOMIC_SEQ_CST);
+    gate_drain(gate, epoch);
+    __atomic_store_n(&gate->draining, 0, __ATOMIC_RELEASE);
+    return epoch;
+}
+
+// start ile şimdi arasındaki süre (mikrosaniye)
+static long elapsed_us(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000000L + (now.tv_nsec - start->tv_nsec) / 1000L;
+}
+
+void snapshotter_init(Snapshotter *snapshots, const char *filename, int interval_ms,
+                      const AccountTable *table, const Journal *journal) {
+    snapshots->filename = filename;
+    snapshots->interval_ms = interval_ms;
+    snapshots->table = table;
+    snapshots->journal = journal;
+    snapshots->copy = (Account *)malloc(table->num_accounts * sizeof(Account));
+    clock_gettime(CLOCK_MONOTONIC, &snapshots->last);
+    snapshots->taken = 0;
+    snapshots->max_pause_us = 0;
+}
+
+int snapshot_due(const Snapshotter *snapshots) {
+    return snapshots->interval_ms > 0 &&
+           elapsed_us(&snapshots->last) >= snapshots->interval_ms * 1000L;
+}
+
+// Hesapların tutarlı bir kesitini okur (snapshot ve denetim ortak yolu)
+// out: NULL değilse hesaplar buraya kopyalanır
+// journal: NULL değilse journal_records'a kesitin journal konumu yazılır
+// pause_us: Worker'ların kapıda bekledikleri süre (kapı hiç kapanmadıysa 0)
+// Dönüş: Kesitteki bakiyelerin toplamı
+static int64_t take_cut(SnapshotGate *gate, const AccountTable *table, const Journal *journal,
+                        Account *out, uint32_t *journal_records, long *pause_us) {
+    struct timespec pause_start;
+    clock_gettime(CLOCK_MONOTONIC, &pause_start);
+    *pause_us = 0;
+    int epoch = -1;  // Çalışan işlem yoksa etiketlere bakılmaz
+    int closed = 0;
+
+    if (gate != NULL && (gate->blocking || journal != NULL)) {
+        // Kapı kapalıyken hiçbir işlem yarım değildir; bu andan önce uygulanan işlemlerin
+        // hepsi journal halkasında yer ayırdı, sonrakilerin hiçbiri ayırmadı
+        gate_close(gate);
+        closed = 1;
+        if (!gate->blocking) {
+            epoch = gate->epoch + 1;
+            __atomic_store_n(&gate->epoch, epoch, __ATOMIC_SEQ_CST);
+        }
+    } else if (gate != NULL) {
+        epoch = gate_advance(gate);
+    }
+    if (journal != NULL) {
+        *journal_records = (uint32_t)__atomic_load_n(&journal->ring->tail, __ATOMIC_ACQUIRE);
+    }
+
+    // -c dışında hesaplar kapı açıkken, worker'lar çalışmaya devam ederken okunur
+    if (closed && !gate->blocking) {
+        gate_open(gate);
+        *pause_us = elapsed_us(&pause_start);
+    }
+    int64_t total = account_table_cut(table, epoch, out);
+    if (closed && gate->blocking) {
+        gate_open(gate);
+        *pause_us = elapsed_us(&pause_start);
+    }
+    return total;
+}
+
+int snapshot_take(Snapshotter *snapshots, SnapshotGate *gate) {
+    uint32_t journal_records = 0;
+    long pause_us;
+    take_cut(gate, snapshots->table, snapshots->journal, snapshots->copy, &journal_records, &pause_us);
+    if (pause_us > snapshots->max_pause_us) {
+        snapshots->max_pause_us = pause_us;
+    }
+
+    // Yavaş kısım (yazma + fsync) worker'lar çalışırken yapılır
+    clock_gettime(CLOCK_MONOTONIC, &snapshots->last);
+    if (write_binary_accounts(snapshots->filename, snapshots->copy, snapshots->table->num_accounts, journal_records) == -1) {
+        return -1;
+    }
+    snapshots->taken++;
+    return 0;
+}
+
+int snapshot_load(const char *filename, Account **accounts, long *journal_records) {
+    uint32_t aux = 0;
+    int count = read_binary_accounts(filename, accounts, &aux);
+    if (journal_records != NULL) {
+        *journal_records = aux;
+    }
+    return count;
+}
+
+void snapshotter_destroy(Snapshotter *snapshots) {
+    free(snapshots->copy);
+    snapshots->copy = NULL;
+}
+
+void auditor_init(Auditor *audits, int interval_ms, const AccountTable *table) {
+    audits->interval_ms = interval_ms;
+    audits->table = table;
+    clock_gettime(CLOCK_MONOTONIC, &audits->last);
+    audits->taken = 0;
+    audits->min_total = 0;
+    audits->max_total = 0;
+    audits->last_total = 0;
+    audits->max_us = 0;
+    audits->max_pause_us = 0;
+}
+
+int audit_due(const Auditor *audits) {
+    return audits->interval_ms > 0 &&
+           elapsed_us(&audits->last) >= audits->interval_ms * 1000L;
+}
+
+int64_t audit_take(Auditor *audits, SnapshotGate *gate) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long pause_us;
+    int64_t total = take_cut(gate, audits->table, NULL, NULL, NULL, &pause_us);
+
+    long audit_us = elapsed_us(&start);
+    if (audits->taken == 0 || total < audits->min_total) {
+        audits->min_total = total;
+    }
+    if (audits->taken == 0 || total > audits->max_total) {
+        audits->max_total = total;
+    }
+    audits->last_total = total;
+    if (audit_us > audits->max_us) {
+        audits->max_us = audit_us;
+    }
+    if (pause_us > audits->max_pause_us) {
+        audits->max_pause_us = pause_us;
+    }
+    audits->taken++;
+    clock_gettime(CLOCK_MONOTONIC, &audits->last);
+    return total;
+}
@@ -1,131 +1,352 @@
 #include "../include/transactions.h"  // İşlem fonksiyonları için tanımlar
 #include "../include/utils.h"         // Semaphore fonksiyonları
+#include "../include/ingest.h"        // mmap tabanlı işlem okuyucu
+#include "../include/binfmt.h"        // İkili hesap dosyası
+#include "../include/aggregate.h"     // DEPOSIT_FOLDED
 #include <stdio.h>                    // Dosya işlemleri
 #include <stdlib.h>                   // Bellek ayırma
-#include <string.h>                   // String kopyalama vs.
-// Deadlock oluşmaması için her zaman küçük ID'li hesabı önce kilitler
-void lock_accounts(int sem_id, int account1, int account2) {
-    if (account1 < account2) {
-        sem_p(sem_id, account1); // önce küçük olanı
-        sem_p(sem_id, account2);
-    } else {
-        sem_p(sem_id, account2);
-        sem_p(sem_id, account1);
+// Açık journal (worker'lar fork edilmeden önce ayarlanır, child'lar kopyasını kullanır)
+// NULL ise journal tutulmaz
+static Journal *active_journal = NULL;
+// Bu process'in journal'a eklediği son kaydın konumu + 1 (journal_wait_synced için)
+static long journal_position = 0;
+// Bakiyeye yazan her yol önce hesabın sürüm etiketini günceller (account_version_touch),
+// böylece snapshot ve denetimler işlemleri durdurmadan tutarlı bir kesit okur
+// Kilit altında bakiye değişikliği: hesaba bu sırada başka kimse yazmaz
+static void balance_change(AccountTable *table, int slot, int amount) {
+    int behind = account_version_touch(table, slot);
+    *account_balance(table, slot) += amount;
+    if (behind) {
+        account_version_carry(table, slot, amount);
     }
 }
-void unlock_accounts(int sem_id, int account1, int account2) {
-    sem_v(sem_id, account1); // önce biri sonra diğeri
-    sem_v(sem_id, account2);
+// Kilitsiz bakiye arttırma: tek bir atomik fetch-add
+static void balance_add(AccountTable *table, int slot, int amount) {
+    int behind = account_version_touch(table, slot);
+    __atomic_fetch_add(account_balance(table, slot), amount, __ATOMIC_RELAXED);
+    if (behind) {
+        account_version_carry(table, slot, amount);
+    }
 }
-int process_deposit(Account *accounts, TransactionLog *logs, int account_id, int amount, int transaction_id, int sem_id) {
-    sem_p(sem_id, account_id);  // Hesabı kilitle
+// Kilitsiz bakiye azaltma: CAS döngüsü, bakiye yetmiyorsa hiçbir şey değiştirmeden FAILURE
+static int balance_try_sub(AccountTable *table, int slot, int amount) {
+    int *balance = account_balance(table, slot);
+    int behind = account_version_touch(table, slot);
+    int current = __atomic_load_n(balance, __ATOMIC_RELAXED);
+    do {
+        if (current < amount) {
+            return FAILURE;  // Yetersiz bakiye
+        }
+        // Başka bir process araya girdiyse current güncellenir ve tekrar denenir
+    } while (!__atomic_compare_exchange_n(balance, &current, current - amount, 1,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    if (behind) {
+        account_version_carry(table, slot, -amount);
+    }
+    return SUCCESS;
+}
+// STATS=1: yetersiz bakiye yüzünden başarısız olan para çıkışını hesaba yazar
+// (normal derlemede hiçbir kod üretmez; locks sadece kullanılmış sayılır, borç yarısı
+// kilit almaz ve LockSet'i sadece bu sayaç için alır)
+#ifdef BANK_STATS
+#define COUNT_FAILED_DEBIT(locks, slot, result) \
+    do { \
+        if ((result) == FAILURE && (slot) != -1 && (locks)->stats != NULL) { \
+            account_stats_failed((locks)->stats, (slot)); \
+        } \
+    } while (0)
+#else
+#define COUNT_FAILED_DEBIT(locks, slot, result) ((void)(locks))
+#endif
+int process_deposit(AccountTable *table, LogRing *logs, int64_t account_id, int amount, int transaction_id, LockSet *locks) {
+    // Hesap ID'sini dizideki yerine çevir; bilinmeyen hesaba işlem yapılmaz
+    int slot = account_table_find(table, account_id);
+    if (slot == -1) {
+        log_append(logs, transaction_id, DEPOSIT, -1, account_id, amount, LOG_FAILED);
+        return FAILURE;
+    }
 
-    accounts[account_id].balance += amount;  // Parayı ekle
+    if (locks->lock_free_single) {
+        balance_add(table, slot, amount);  // Kilit almadan parayı ekle
+    } else {
+        lock_account(locks, slot);  // Hesabı kilitle
+        balance_change(table, slot, amount);  // Parayı ekle
+        unlock_account(locks, slot);  // Hesabı aç kilit açılıyor 
+    }
+
+    // Log kaydı: kaynak hesap yok çünkü para sistem dışından geliyor
+    log_append(logs, transaction_id, DEPOSIT, -1, account_id, amount, LOG_SUCCESS);
+    return SUCCESS;
+}
+int process_deposit_run(AccountTable *table, LogRing *logs, int64_t account_id, int amount, int total, int transaction_id, LockSet *locks) {
+    // Katlanan yatırma: toplamı serinin lideri uygular, burada sadece log kaydı yazılır
+    if (total == DEPOSIT_FOLDED) {
+        log_append(logs, transaction_id, DEPOSIT, -1, account_id, amount, LOG_SUCCESS);
+        return SUCCESS;
+    }
 
-    // Log kaydı
-    logs[transaction_id].transaction_id = transaction_id;
-    strcpy(logs[transaction_id].type, "Deposit");
-    logs[transaction_id].from_account = -1;           // kaynak hesap yok çünkü para sistem dışından geliyor 
-    logs[transaction_id].to_account = account_id; // hedef hesap
-    logs[transaction_id].amount = amount;
-    strcpy(logs[transaction_id].status, "Success");
+    // Lider: serinin toplamı tek bir bakiye güncellemesi (ön toplama hesabın var olduğunu kontrol etti)
+    int slot = account_table_find(table, account_id);
+    if (locks->lock_free_single) {
+        balance_add(table, slot, total);
+    } else {
+        lock_account(locks, slot);
+        balance_change(table, slot, total);
+        unlock_account(locks, slot);
+    }
+    log_append(logs, transaction_id, DEPOSIT, -1, account_id, amount, LOG_SUCCESS);
 
-    sem_v(sem_id, account_id);  // Hesabı aç kilit açılıyor 
+    // Journal'a seri başına tek kayıt: katlanan yatırmalar bakiyeye bu kayıtla girer
+    if (active_journal != NULL) {
+        journal_position = journal_append(active_journal, transaction_id, DEPOSIT, -1, account_id, total);
+    }
     return SUCCESS;
 }
-int process_withdraw(Account *accounts, TransactionLog *logs, int account_id, int amount, int transaction_id, int sem_id) {
-    sem_p(sem_id, account_id);  // Hesabı kilitle
-
-    if (accounts[account_id].balance < amount) {  // Bakiye yeterli mi?
-        // Başarısız log kaydı
-        logs[transaction_id].transaction_id = transaction_id;
-        strcpy(logs[transaction_id].type, "Withdraw");
-        logs[transaction_id].from_account = account_id;
-        logs[transaction_id].to_account = -1;// hedef hesap yok çünkü para sistem dışına gidiyor
-        logs[transaction_id].amount = amount;
-        strcpy(logs[transaction_id].status, "Failed");
-
-        sem_v(sem_id, account_id);  // Kilidi bırak
-        return FAILURE;
+int process_withdraw(AccountTable *table, LogRing *logs, int64_t account_id, int amount, int transaction_id, LockSet *locks) {
+    int result;
+    int slot = account_table_find(table, account_id);
+    if (slot == -1) {
+        result = FAILURE;  // Bilinmeyen hesap
+    } else if (locks->lock_free_single) {
+        result = balance_try_sub(table, slot, amount);  // Kilit almadan CAS ile düş
+    } else {
+        lock_account(locks, slot);  // Hesabı kilitle
+        if (*account_balance(table, slot) < amount) {  // Bakiye yeterli mi?
+            result = FAILURE;
+        } else {
+            balance_change(table, slot, -amount);  // Bakiye düşürülür
+            result = SUCCESS;
+        }
+        unlock_account(locks, slot);  // Kilidi bırak
     }
+    COUNT_FAILED_DEBIT(locks, slot, result);
 
-    // Bakiye düşürülür
-    accounts[account_id].balance -= amount;
+    // Log kaydı: hedef hesap yok çünkü para sistem dışına gidiyor
+    log_append(logs, transaction_id, WITHDRAW, account_id, -1, amount,
+               result == SUCCESS ? LOG_SUCCESS : LOG_FAILED);
+    return result;
+}
+int process_transfer(AccountTable *table, LogRing *logs, int64_t from_account, int64_t to_account, int amount, int transaction_id, LockSet *locks) {
+    int from_slot = account_table_find(table, from_account);
+    int to_slot = account_table_find(table, to_account);
+    if (from_slot == -1 || to_slot == -1) {
+        log_append(logs, transaction_id, TRANSFER, from_account, to_account, amount, LOG_FAILED);
+        return FAILURE;  // Bilinmeyen hesap
+    }
 
-    // Başarılı log kaydı
-    logs[transaction_id].transaction_id = transaction_id;
-    strcpy(logs[transaction_id].type, "Withdraw");
-    logs[transaction_id].from_account = account_id; 
-    logs[transaction_id].to_account = -1;
-    logs[transaction_id].amount = amount;
-    strcpy(logs[transaction_id].status, "Success");
+    // İki hesabı da tek seferde kilitle (semaphore backend'inde tek bir semop() çağrısı,
+    // futex backend'inde küçük slot önce alınır, deadlock oluşmaz)
+    int lock_slots[2] = { from_slot, to_slot };
+    int num_locked = lock_account_set(locks, lock_slots, 2);
 
-    sem_v(sem_id, account_id);  // Kilidi bırak
+    // Kilitler başka transfer'lara karşı korur; ama kilitsiz yatırma/çekme işlemleri
+    // kilidi hiç almadığı için bakiyeler yine atomik olarak değiştirilir
+    int result = balance_try_sub(table, from_slot, amount);  // Yeterli para yoksa FAILURE
+    if (result == SUCCESS) {
+        balance_add(table, to_slot, amount);
+    }
+
+    unlock_account_set(locks, lock_slots, num_locked);
+    COUNT_FAILED_DEBIT(locks, from_slot, result);
+
+    // Log kaydı kilitler bırakıldıktan sonra yazılır
+    log_append(logs, transaction_id, TRANSFER, from_account, to_account, amount,
+               result == SUCCESS ? LOG_SUCCESS : LOG_FAILED);
+    return result;
+}
+int process_transfer_debit(AccountTable *table, LogRing *logs, int64_t from_account, int64_t to_account, int amount, int transaction_id, LockSet *locks) {
+    int from_slot = account_table_find(table, from_account);
+    int result = from_slot == -1 ? FAILURE : balance_try_sub(table, from_slot, amount);
+    COUNT_FAILED_DEBIT(locks, from_slot, result);
+
+    // Sadece reddedilen transfer burada loglanır; başarılı olanı alacak yarısı loglar
+    if (result != SUCCESS) {
+        log_append(logs, transaction_id, TRANSFER, from_account, to_account, amount, LOG_FAILED);
+    }
+    return result;
+}
+int process_transfer_credit(AccountTable *table, LogRing *logs, int64_t from_account, int64_t to_account, int amount, int transaction_id) {
+    int to_slot = account_table_find(table, to_account);
+    balance_add(table, to_slot, amount);  // Borç tarafı hesabın var olduğunu kontrol etti
+
+    // Transfer şimdi tamamlandı: log ve journal kaydı tek seferde
+    log_append(logs, transaction_id, TRANSFER, from_account, to_account, amount, LOG_SUCCESS);
+    if (active_journal != NULL) {
+        journal_position = journal_append(active_journal, transaction_id, TRANSFER, from_account, to_account,
+                                          amount);
+    }
     return SUCCESS;
 }
-int process_transfer(Account *accounts, TransactionLog *logs, int from_account, int to_account, int amount, int transaction_id, int sem_id) {
-    lock_accounts(sem_id, from_account, to_account);  // İki hesabı da güvenli şekilde kilitle
-
-    if (accounts[from_account].balance < amount) {  // Yeterli para yoksa
-        // Başarısız log
-        logs[transaction_id].transaction_id = transaction_id;
-        strcpy(logs[transaction_id].type, "Transfer");
-        logs[transaction_id].from_account = from_account;
-        logs[transaction_id].to_account = to_account;
-        logs[transaction_id].amount = amount;
-        strcpy(logs[transaction_id].status, "Failed");
-
-        unlock_accounts(sem_id, from_account, to_account);
+int process_multi_leg(AccountTable *table, LogRing *logs, const Leg *legs, int num_legs, int transaction_id, LockSet *locks) {
+    // Log kaydı için ilk borçlu hesap ve toplam borç (okuyucu en az bir borç garanti eder)
+    int64_t first_debit = -1;
+    int total = 0;
+    for (int k = 0; k < num_legs; k++) {
+        if (legs[k].amount < 0) {
+            if (first_debit == -1) {
+                first_debit = legs[k].account_id;
+            }
+            total -= legs[k].amount;
+        }
+    }
+
+    // Tüm ayakların slot'ları; bilinmeyen hesap varsa hiçbir şeye dokunulmaz
+    int slots[MULTI_MAX_LEGS];
+    int lock_slots[MULTI_MAX_LEGS];
+    int result = SUCCESS;
+    for (int k = 0; k < num_legs; k++) {
+        slots[k] = account_table_find(table, legs[k].account_id);
+        lock_slots[k] = slots[k];
+        if (slots[k] == -1) {
+            result = FAILURE;
+        }
+    }
+    if (result == FAILURE) {
+        log_append(logs, transaction_id, MULTI_LEG, first_debit, num_legs, total, LOG_FAILED);
         return FAILURE;
     }
 
-    // Transfer işlemi
-    accounts[from_account].balance -= amount;
-    accounts[to_account].balance += amount;
+    // Tüm hesaplar tek bir set olarak kilitlenir (slot sırasıyla, transfer ile aynı yol)
+    int num_locked = lock_account_set(locks, lock_slots, num_legs);
 
-    // Log
-    logs[transaction_id].transaction_id = transaction_id;
-    strcpy(logs[transaction_id].type, "Transfer");
-    logs[transaction_id].from_account = from_account;
-    logs[transaction_id].to_account = to_account;
-    logs[transaction_id].amount = amount;
-    strcpy(logs[transaction_id].status, "Success");
+    // 1. geçiş: hiçbir bakiye değişmeden önce her borç karşılanıyor mu?
+    for (int k = 0; k < num_legs && result == SUCCESS; k++) {
+        if (legs[k].amount < 0 && *account_balance(table, slots[k]) < -legs[k].amount) {
+            result = FAILURE;
+            COUNT_FAILED_DEBIT(locks, slots[k], result);
+        }
+    }
 
-    unlock_accounts(sem_id, from_account, to_account);
-    return SUCCESS;
-}
-int read_transactions(const char *filename, int **t_type, int **from_acc, int **to_acc, int **amount) {
-    FILE *file = fopen(filename, "r");
-    if (file == NULL) {
-        perror("Error opening transactions file");
-        return -1;
+    // 2. geçiş: borçlar, sonra alacaklar. Kilitsiz yatırma/çekme (-c) kontrol ile borç
+    // arasında bakiyeyi düşürmüş olabilir: o zaman yapılan borçlar geri alınır
+    if (result == SUCCESS) {
+        int debited = 0;
+        while (debited < num_legs) {
+            if (legs[debited].amount < 0 &&
+                balance_try_sub(table, slots[debited], -legs[debited].amount) != SUCCESS) {
+                result = FAILURE;
+                break;
+            }
+            debited++;
+        }
+        if (result == FAILURE) {
+            for (int k = 0; k < debited; k++) {
+                if (legs[k].amount < 0) {
+                    balance_add(table, slots[k], -legs[k].amount);
+                }
+            }
+        } else {
+            for (int k = 0; k < num_legs; k++) {
+                if (legs[k].amount > 0) {
+                    balance_add(table, slots[k], legs[k].amount);
+                }
+            }
+        }
     }
 
-    int count = 0;
-    char line[256];
-    while (fgets(line, sizeof(line), file) != NULL) {
-        count++;  // Kaç işlem olduğunu say
+    unlock_account_set(locks, lock_slots, num_locked);
+
+    log_append(logs, transaction_id, MULTI_LEG, first_debit, num_legs, total,
+               result == SUCCESS ? LOG_SUCCESS : LOG_FAILED);
+    if (result == SUCCESS && active_journal != NULL) {
+        journal_position = journal_append_multi(active_journal, transaction_id, legs, num_legs, first_debit,
+                                                total);
+    }
+    return result;
+}
+int execute_transaction(AccountTable *table, LogRing *logs, const Transaction *txn, const Leg *legs, int transaction_id, LockSet *locks) {
+    int result;
+    switch (txn->type) {
+        case DEPOSIT:
+            result = process_deposit(table, logs, txn->to_account, txn->amount, transaction_id, locks);
+            break;
+        case WITHDRAW:
+            result = process_withdraw(table, logs, txn->from_account, txn->amount, transaction_id, locks);
+            break;
+        case TRANSFER:
+            result = process_transfer(table, logs, txn->from_account, txn->to_account, txn->amount, transaction_id, locks);
+            break;
+        case MULTI_LEG:
+            if (legs == NULL) {
+                // Ayakları taşımayan yol (ör. daemon protokolü): işlem uygulanamaz
+                log_append(logs, transaction_id, MULTI_LEG, -1, 0, txn->amount, LOG_FAILED);
+                return FAILURE;
+            }
+            // Kendi journal kaydını (başlık + ayaklar) kendisi yazar
+            return process_multi_leg(table, logs, legs + txn->from_account, (int)txn->to_account,
+                                     transaction_id, locks);
+        default:
+            // Bilinmeyen işlem türü: log okuyucu her işlem için bir kayıt beklediğinden yine de yaz
+            log_append(logs, transaction_id, UNKNOWN_TYPE, txn->from_account, txn->to_account,
+                       txn->amount, LOG_FAILED);
+            return FAILURE;
     }
 
-    // Bellek ayır
-    *t_type = (int *)malloc(count * sizeof(int));
-    *from_acc = (int *)malloc(count * sizeof(int));
-    *to_acc = (int *)malloc(count * sizeof(int));
-    *amount = (int *)malloc(count * sizeof(int));
+    // Sadece uygulanan işlemler journal'a gider (başarısız işlem bakiyeleri değiştirmedi)
+    if (result == SUCCESS && active_journal != NULL) {
+        journal_position = journal_append(active_journal, transaction_id, txn->type, txn->from_account,
+                                          txn->to_account, txn->amount);
+    }
+    return result;
+}
+void set_transaction_journal(Journal *journal) {
+    active_journal = journal;
+}
+long transaction_journal_position(void) {
+    return journal_position;
+}
+int read_transactions(const char *filename, Transaction **transactions, Leg **legs) {
+    TransactionReader reader;
+    if (reader_open(&reader, filename) == -1) {
+        return -1;
+    }
 
-    rewind(file);  // Dosyanın başına dön
+    // Diziler büyüdükçe iki katına çıkarılır; dosya tek geçişte okunur. Ayak dizisinde
+    // her zaman bir partinin en kötü durumu (her işlem MULTI_MAX_LEGS ayaklı) için yer vardır
+    int capacity = 1024;
+    int count = 0;
+    long leg_capacity = (long)capacity * MULTI_MAX_LEGS;
+    long num_legs = 0;
+    *transactions = (Transaction *)malloc(capacity * sizeof(Transaction));
+    *legs = (Leg *)malloc(leg_capacity * sizeof(Leg));
 
-    for (int i = 0; i < count; i++) {
-        if (fgets(line, sizeof(line), file) == NULL) break;
+    for (;;) {
+        if (count == capacity) {
+            capacity *= 2;
+            *transactions = (Transaction *)realloc(*transactions, capacity * sizeof(Transaction));
+        }
+        if (leg_capacity - num_legs < (long)(capacity - count) * MULTI_MAX_LEGS) {
+            leg_capacity = num_legs + (long)(capacity - count) * MULTI_MAX_LEGS;
+            *legs = (Leg *)realloc(*legs, leg_capacity * sizeof(Leg));
+        }
+        reader.legs = *legs + num_legs;
+        int n = reader_next_batch(&reader, *transactions + count, capacity - count);
 
-        // <T_type, From_account, To_account, Amount>
-        sscanf(line, "%d, %d, %d, %d", &(*t_type)[i], &(*from_acc)[i], &(*to_acc)[i], &(*amount)[i]);
+        // Ayak indeksleri partiye göre: tüm dosyanın dizisine göre kaydır
+        for (int k = count; k < count + n; k++) {
+            if ((*transactions)[k].type == MULTI_LEG) {
+                (*transactions)[k].from_account += num_legs;
+            }
+        }
+        num_legs += reader.num_legs;
+        count += n;
+        if (count < capacity) {
+            break;  // Dosya bitti
+        }
     }
 
-    fclose(file);
+    reader_close(&reader);
     return count;  // Toplam işlem sayısı
 }
-int initialize_accounts(const char *filename, Account *accounts, int max_accounts) {
+int load_accounts(const char *filename, Account **accounts) {
+    *accounts = NULL;
+
+    // İkili formattaki hesap dosyası parse edilmeden kopyalanır
+    int binary_count = read_binary_accounts(filename, accounts, NULL);
+    if (binary_count != BINARY_NOT_BINARY) {
+        return binary_count;
+    }
+
     FILE *file = fopen(filename, "r");
     if (file == NULL) {
         perror("Error opening accounts file");
@@ -136,27 +357,26 @@ int initialize_accounts(const char *filename, Account *accounts, int max_account
     char line[256];
 
     // İlk satır: toplam hesap sayısı
-    if (fgets(line, sizeof(line), file) != NULL) {
-        sscanf(line, "%d", &account_count);
-
-        // Eğer dosyadaki hesap sayısı sınırı aşarsa kes
-        if (account_count > max_accounts) {
-            printf("Warning: Found %d accounts, but only space for %d. Truncating.\n",
-                   account_count, max_accounts);
-            account_count = max_accounts;
-        }
+    if (fgets(line, sizeof(line), file) == NULL || sscanf(line, "%d", &account_count) != 1 ||
+        account_count < 0) {
+        fclose(file);
+        return 0;  // Boş dosya: çağıran varsayılan hesapları kullanır
     }
 
-    // Hesapları oku
-    for (int i = 0; i < account_count && i < max_accounts; i++) {
-        if (fgets(line, sizeof(line), file) != NULL) {
-            int id, balance;
-            sscanf(line, "%d, %d", &id, &balance);
-            accounts[i].account_id = id;
-            accounts[i].balance = balance;
+    // Hesapları oku (dizi hesap sayısı kadar; ID'ler sıralı veya ardışık olmak zorunda değil)
+    *accounts = (Account *)calloc(account_count > 0 ? account_count : 1, sizeof(Account));
+    int count = 0;
+    while (count < account_count && fgets(line, sizeof(line), file) != NULL) {
+        long long id;
+        int balance;
+        if (sscanf(line, "%lld, %d", &id, &balance) != 2) {
+            continue;  // Boş veya bozuk satır
         }
+        (*accounts)[count].account_id = id;
+        (*accounts)[count].balance = balance;
+        count++;
     }
 
     fclose(file);
-    return account_count;
+    return count;  // Okunan hesap sayısı
 }
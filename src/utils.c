@@ -28,3 +28,90 @@ int sem_v(int sem_id, int sem_num) {
     sem_op.sem_flg = 0;
     return semop(sem_id, &sem_op, 1);  // Yine sadece 1 işlem yapılıyor
 }
+
+// Toplu semaphore işlemi: her semaphore için bir sembuf, hepsi tek semop() ile
+static int sem_batch(int sem_id, const int *sem_nums, int n, int op, int flags) {
+    struct sembuf sem_ops[SEM_BATCH_MAX];
+    for (int i = 0; i < n; i++) {
+        sem_ops[i].sem_num = sem_nums[i];
+        sem_ops[i].sem_op = op;      // -1 kilitle, +1 aç
+        sem_ops[i].sem_flg = flags;  // IPC_NOWAIT: beklemek gerekiyorsa hiçbirini alma
+    }
+    return semop(sem_id, sem_ops, n);  // Kernel dizinin tamamını atomik uygular
+}
+
+int sem_p_batch(int sem_id, const int *sem_nums, int n) {
+    return sem_batch(sem_id, sem_nums, n, -1, 0);
+}
+
+int sem_try_p_batch(int sem_id, const int *sem_nums, int n) {
+    return sem_batch(sem_id, sem_nums, n, -1, IPC_NOWAIT);
+}
+
+int sem_v_batch(int sem_id, const int *sem_nums, int n) {
+    return sem_batch(sem_id, sem_nums, n, 1, 0);
+}
+
+// futex bekleme: shared memory'deki kelime process'ler arasında paylaşıldığı için
+// FUTEX_PRIVATE_FLAG kullanılmaz
+int futex_wait(int *addr, int expected) {
+    return syscall(SYS_futex, addr, FUTEX_WAIT, expected, NULL, NULL, 0);
+}
+
+// futex uyandırma
+int futex_wake(int *addr, int count) {
+    return syscall(SYS_futex, addr, FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+// shared_alloc() process'e özel bellek mi veriyor? (-e threads)
+static int private_memory_enabled = 0;
+
+void set_private_memory(int private_memory) {
+    private_memory_enabled = private_memory;
+}
+
+void *shared_alloc(size_t size, const char *what) {
+    if (private_memory_enabled) {
+        // Anonim eşleme: shared memory gibi sayfa hizalı ve sayfalar dokunulunca ayrılır
+        // İlk sayfa eşlemenin boyutunu tutar (shared_free munmap için okur)
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        char *base = (char *)mmap(NULL, size + page, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            fprintf(stderr, "mmap failed for %s: %s\n", what, strerror(errno));
+            return NULL;
+        }
+        *(size_t *)base = size + page;
+        return base + page;
+    }
+
+    return shm_alloc(size, what);
+}
+
+void shared_free(void *area) {
+    if (private_memory_enabled) {
+        char *base = (char *)area - sysconf(_SC_PAGESIZE);
+        munmap(base, *(size_t *)base);
+    } else {
+        shm_free(area);
+    }
+}
+
+void *shm_alloc(size_t size, const char *what) {
+    int shm_id = shmget(IPC_PRIVATE, size > 0 ? size : 1, IPC_CREAT | 0666);
+    if (shm_id == -1) {
+        fprintf(stderr, "shmget failed for %s: %s\n", what, strerror(errno));
+        return NULL;
+    }
+    void *area = shmat(shm_id, NULL, 0);
+    shmctl(shm_id, IPC_RMID, NULL);  // Son bağlantı kopunca kernel silsin
+    if (area == (void *)-1) {
+        fprintf(stderr, "shmat failed for %s: %s\n", what, strerror(errno));
+        return NULL;
+    }
+    return area;  // shmget belleği sıfırlar
+}
+
+void shm_free(void *area) {
+    shmdt(area);
+}